@@ -0,0 +1,88 @@
+
+// CONNECTIONS:
+// DS3231 SDA --> SDA
+// DS3231 SCL --> SCL
+// DS3231 VCC --> 3.3v or 5v
+// DS3231 GND --> GND
+// SQW --->  (Pin2) Don't forget to pullup (4.7k to 10k to VCC)
+
+/* for normal hardware wire use below */
+#include <Wire.h> // must be included here so that Arduino library object file references work
+#include <RtcDS3231.h>
+#include <RtcTickClock.h>
+RtcDS3231<TwoWire> Rtc(Wire);
+/* for normal hardware wire use above */
+
+#define RtcSquareWavePin 2 // Uno
+
+// counts the seconds from the square wave, reading it does not use the RTC
+RtcTickClock Clock;
+
+void ISR_ATTR InteruptServiceRoutine()
+{
+    // the RTC seconds change on the falling edge
+    Clock.Tick();
+}
+
+void setup ()
+{
+    Serial.begin(57600);
+
+    // set the interupt pin to input mode
+    pinMode(RtcSquareWavePin, INPUT);
+
+    Rtc.Begin();
+
+    RtcDateTime compiled = RtcDateTime(__DATE__, __TIME__);
+
+    if (!Rtc.IsDateTimeValid())
+    {
+        Serial.println("RTC lost confidence in the DateTime!");
+        Rtc.SetDateTime(compiled);
+    }
+
+    if (!Rtc.GetIsRunning())
+    {
+        Serial.println("RTC was not actively running, starting now");
+        Rtc.SetIsRunning(true);
+    }
+
+    Rtc.Enable32kHzPin(false);
+    Rtc.SetSquareWavePinClockFrequency(DS3231SquareWaveClock_1Hz);
+    Rtc.SetSquareWavePin(DS3231SquareWavePin_ModeClock);
+
+    // setup external interupt, then take the time from the RTC once
+    attachInterrupt(digitalPinToInterrupt(RtcSquareWavePin), InteruptServiceRoutine, FALLING);
+    Clock.Begin(Rtc);
+}
+
+void loop ()
+{
+    uint32_t microseconds;
+    RtcDateTime now = RtcDateTime(Clock.NowSeconds(&microseconds));
+
+    printDateTime(now);
+    Serial.print(" +");
+    Serial.print(microseconds);
+    Serial.println("us");
+
+    delay(250);
+}
+
+#define countof(a) (sizeof(a) / sizeof(a[0]))
+
+void printDateTime(const RtcDateTime& dt)
+{
+	char datestring[20];
+
+	snprintf_P(datestring,
+			countof(datestring),
+			PSTR("%02u/%02u/%04u %02u:%02u:%02u"),
+			dt.Month(),
+			dt.Day(),
+			dt.Year(),
+			dt.Hour(),
+			dt.Minute(),
+			dt.Second() );
+    Serial.print(datestring);
+}
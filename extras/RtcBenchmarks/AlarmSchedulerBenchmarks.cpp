@@ -0,0 +1,135 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <RtcDS3231.h>
+#include <RtcDS3234.h>
+#include <RtcAlarmScheduler.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+
+const uint8_t c_SchedulerAlarms = 48;
+static uint8_t alarmCalls[c_SchedulerAlarms];
+static uint8_t alarmCallCount = 0;
+
+static void RecordAlarm(uint8_t id)
+{
+    if (alarmCallCount < c_SchedulerAlarms)
+        alarmCalls[alarmCallCount++] = id;
+}
+
+static bool IsAlarmOneProgrammed(RtcDS3231<SimulatedTwoWire>& rtc, uint32_t deadline)
+{
+    RtcDateTime dt(deadline);
+    return rtc.GetAlarmOne() == DS3231AlarmOne(dt.Day(), dt.Hour(), dt.Minute(), dt.Second(),
+        DS3231AlarmOneControl_HoursMinutesSecondsDayOfMonthMatch);
+}
+
+void AlarmSchedulerBenchmarks()
+{
+    Serial.println("Alarm scheduler:");
+
+    typedef RtcAlarmScheduler<RtcDS3231<SimulatedTwoWire>, DS3231AlarmOne, c_SchedulerAlarms> Scheduler;
+
+    const uint32_t c_Now = RtcDateTime(2024, 2, 29, 23, 58, 0).TotalSeconds();
+    const uint8_t c_Added = 40;
+
+    SimulatedTwoWire wire;
+    SimulatedDs3231 device;
+    wire.Attach(device);
+    RtcDS3231<SimulatedTwoWire> rtc(wire);
+    rtc.SetDateTime(RtcDateTime(c_Now));
+
+    Scheduler scheduler(rtc);
+    uint32_t deadlines[c_SchedulerAlarms];
+
+    // spread over the next 400 seconds in a scrambled order, the first is the
+    // earliest so only it uses the bus
+    wire.Statistics.Reset();
+    uint32_t start = micros();
+    bool isAdded = true;
+    for (uint8_t index = 0; index < c_Added; index++) {
+        uint32_t deadline = c_Now + 10 + (index * 37) % 400;
+        uint8_t id = scheduler.Add(deadline, RecordAlarm);
+
+        isAdded = isAdded && id != c_RtcAlarmInvalid;
+        deadlines[id] = deadline;
+    }
+    PrintlnPerIteration("Add", micros() - start, c_Added);
+    PrintlnBusCost("Add x 40", wire);
+    PrintlnCheck("earliest deadline programmed", isAdded && scheduler.Count() == c_Added &&
+        scheduler.NextDeadline() == c_Now + 10 && IsAlarmOneProgrammed(rtc, c_Now + 10));
+
+    // removing never uses the bus, the earliest one included
+    wire.Statistics.Reset();
+    start = micros();
+    for (uint8_t id = 0; id < c_Added; id += 4)
+        scheduler.Remove(id);
+    PrintlnPerIteration("Remove", micros() - start, c_Added / 4);
+    PrintlnCheck("remove without bus traffic", wire.Statistics.transactions == 0 &&
+        scheduler.Count() == c_Added - c_Added / 4 && !scheduler.IsScheduled(0) && !scheduler.Remove(0) &&
+        scheduler.NextDeadline() > c_Now + 10);
+
+    // the removed alarm still fires, then the 200 seconds pass
+    device.AdvanceSeconds(10);
+    device.TriggerAlarms(DS3231AlarmFlag_Alarm1);
+    uint8_t flags = scheduler.Process();
+    PrintlnCheck("removed alarm not called", flags == DS3231AlarmFlag_Alarm1 && alarmCallCount == 0 &&
+        IsAlarmOneProgrammed(rtc, scheduler.NextDeadline()));
+
+    device.AdvanceSeconds(190);
+    device.TriggerAlarms(DS3231AlarmFlag_Alarm1);
+    wire.Statistics.Reset();
+    scheduler.Process();
+    PrintlnBusCost("Process", wire);
+
+    bool isOrdered = true;
+    uint8_t due = 0;
+    for (uint8_t id = 0; id < c_Added; id++) {
+        if ((id % 4) && deadlines[id] <= c_Now + 200) due++;
+    }
+    for (uint8_t index = 0; index < alarmCallCount; index++) {
+        uint8_t id = alarmCalls[index];
+        isOrdered = isOrdered && (id % 4) && deadlines[id] <= c_Now + 200 &&
+            (index == 0 || deadlines[alarmCalls[index - 1]] <= deadlines[id]);
+    }
+    PrintlnCheck("due alarms called in order", isOrdered && alarmCallCount == due &&
+        scheduler.Count() == c_Added - c_Added / 4 - due &&
+        scheduler.NextDeadline() > c_Now + 200 && IsAlarmOneProgrammed(rtc, scheduler.NextDeadline()));
+
+    // already due, called back at once and then every minute
+    alarmCallCount = 0;
+    uint8_t periodic = scheduler.Add(c_Now, RecordAlarm, 60);
+    PrintlnCheck("past deadline called at once", alarmCallCount == 1 && alarmCalls[0] == periodic &&
+        scheduler.IsScheduled(periodic) && IsAlarmOneProgrammed(rtc, scheduler.NextDeadline()));
+
+    alarmCallCount = 0;
+    device.AdvanceSeconds(40);
+    device.TriggerAlarms(DS3231AlarmFlag_Alarm1);
+    scheduler.Process();
+    bool isRepeated = false;
+    for (uint8_t index = 0; index < alarmCallCount; index++)
+        isRepeated = isRepeated || alarmCalls[index] == periodic;
+    PrintlnCheck("periodic alarm repeats", isRepeated && scheduler.IsScheduled(periodic) &&
+        scheduler.NextDeadline() > c_Now + 240);
+
+    while (scheduler.Add(c_Now + 100000, RecordAlarm) != c_RtcAlarmInvalid) {
+    }
+    PrintlnCheck("full", scheduler.Count() == c_SchedulerAlarms);
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+        rtc.SetDateTime(RtcDateTime(c_Now));
+
+        RtcAlarmScheduler<RtcDS3234<SimulatedDs3234>, DS3234AlarmOne> scheduler(rtc);
+        scheduler.Add(c_Now + 3600, RecordAlarm);
+        scheduler.Add(c_Now + 90, RecordAlarm);
+
+        RtcDateTime next(c_Now + 90);
+        PrintlnCheck("DS3234 alarm one", rtc.GetAlarmOne() == DS3234AlarmOne(next.Day(), next.Hour(),
+            next.Minute(), next.Second(), DS3234AlarmOneControl_HoursMinutesSecondsDayOfMonthMatch));
+    }
+
+    Serial.println();
+}
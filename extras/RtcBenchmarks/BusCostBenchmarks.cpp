@@ -0,0 +1,113 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <ThreeWire.h>
+#include <RtcDS1302.h>
+#include <RtcDS1307.h>
+#include <RtcDS3231.h>
+#include <RtcDS3234.h>
+#include <EepromAT24C32.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedDs1307.h"
+#include "SimulatedAt24c32.h"
+#include "SimulatedDs1302.h"
+
+void BusCostBenchmarks()
+{
+    Serial.println("Bus cost per call:");
+
+    const RtcDateTime now(2024, 2, 29, 12, 34, 56);
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        rtc.SetDateTime(now);
+        PrintlnBusCost("DS3231 SetDateTime", wire);
+        rtc.GetDateTime();
+        PrintlnBusCost("DS3231 GetDateTime", wire);
+        rtc.GetTemperature();
+        PrintlnBusCost("DS3231 GetTemperature", wire);
+        rtc.IsDateTimeValid();
+        PrintlnBusCost("DS3231 IsDateTimeValid", wire);
+        rtc.SetSquareWavePin(DS3231SquareWavePin_ModeAlarmOne);
+        PrintlnBusCost("DS3231 SetSquareWavePin", wire);
+        rtc.SetAlarmOne(DS3231AlarmOne(1, 2, 3, 4, DS3231AlarmOneControl_HoursMinutesSecondsMatch));
+        PrintlnBusCost("DS3231 SetAlarmOne", wire);
+        rtc.GetAlarmOne();
+        PrintlnBusCost("DS3231 GetAlarmOne", wire);
+        rtc.LatchAlarmsTriggeredFlags();
+        PrintlnBusCost("DS3231 LatchAlarmsTriggeredFlags", wire);
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+
+        rtc.SetDateTime(now);
+        PrintlnBusCost("DS3234 SetDateTime", spi);
+        rtc.GetDateTime();
+        PrintlnBusCost("DS3234 GetDateTime", spi);
+        rtc.GetTemperature();
+        PrintlnBusCost("DS3234 GetTemperature", spi);
+        rtc.SetSquareWavePin(DS3234SquareWavePin_ModeAlarmOne);
+        PrintlnBusCost("DS3234 SetSquareWavePin", spi);
+
+        uint8_t memory[32];
+        rtc.GetMemory(0, memory, sizeof(memory));
+        PrintlnBusCost("DS3234 GetMemory 32", spi);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs1307 device;
+        wire.Attach(device);
+        RtcDS1307<SimulatedTwoWire> rtc(wire);
+
+        rtc.SetDateTime(now);
+        PrintlnBusCost("DS1307 SetDateTime", wire);
+        rtc.GetDateTime();
+        PrintlnBusCost("DS1307 GetDateTime", wire);
+
+        uint8_t memory[32];
+        rtc.GetMemory(0, memory, sizeof(memory));
+        PrintlnBusCost("DS1307 GetMemory 32", wire);
+    }
+
+    {
+        SimulatedDs1302 wire;
+        RtcDS1302<SimulatedDs1302> rtc(wire);
+
+        rtc.SetIsWriteProtected(false);
+        wire.Statistics.Reset();
+
+        rtc.SetDateTime(now);
+        PrintlnBusCost("DS1302 SetDateTime", wire);
+        rtc.GetDateTime();
+        PrintlnBusCost("DS1302 GetDateTime", wire);
+
+        uint8_t memory[DS1302RamSize];
+        rtc.GetMemory(memory, sizeof(memory));
+        PrintlnBusCost("DS1302 GetMemory 31", wire);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+
+        uint8_t memory[30] = { 0 };
+        eeprom.SetMemory(0, memory, sizeof(memory));
+        PrintlnBusCost("AT24C32 SetMemory 30", wire);
+        delay(10); // write cycle
+        eeprom.GetMemory(0, memory, sizeof(memory));
+        PrintlnBusCost("AT24C32 GetMemory 30", wire);
+    }
+
+    Serial.println();
+}
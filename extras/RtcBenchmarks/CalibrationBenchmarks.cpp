@@ -0,0 +1,260 @@
+#include <Arduino.h>
+#include <RtcDS1307.h>
+#include <RtcDS3231.h>
+#include <EepromAT24C32.h>
+#include <RtcMemoryStore.h>
+#include <RtcAgingCalibration.h>
+#include <RtcDriftModel.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedDs1307.h"
+#include "SimulatedAt24c32.h"
+
+static void AgingCalibrationBenchmarks()
+{
+    Serial.println("Aging calibration:");
+
+    typedef RtcMemoryStore<EepromAt24c32<SimulatedTwoWire>, 48> CalibrationStore;
+
+    const uint32_t c_Start = RtcDateTime(2024, 2, 29, 12, 0, 0).TotalSeconds();
+    const uint32_t c_SampleSeconds = 1800;
+    const uint32_t c_WindowSeconds = 86400;
+    // the simulated RTC gains 2.5ppm and each sample is off by up to a tick
+    const float c_DriftPpm = 2.5f;
+
+    SimulatedTwoWire wire;
+    SimulatedDs3231 device;
+    SimulatedAt24c32 memory;
+    wire.Attach(device);
+    wire.Attach(memory);
+    wire.SetRealTimeLatency(true);
+    RtcDS3231<SimulatedTwoWire> rtc(wire);
+    EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+    rtc.SetAgingOffset(-3);
+
+    CalibrationStore store(eeprom);
+    store.Begin();
+    RtcAgingCalibration<RtcDS3231<SimulatedTwoWire>, CalibrationStore> calibration(rtc, store, c_WindowSeconds);
+    PrintlnCheck("no samples stored", !calibration.Begin() && calibration.DriftPpm() == 0.0f);
+
+    uint32_t elapsedMicros = 0;
+    uint16_t samples = 0;
+    for (uint32_t seconds = 0; seconds <= c_WindowSeconds; seconds += c_SampleSeconds) {
+        int32_t noise = static_cast<int32_t>(samples % 3) - 1;
+        int32_t gained = static_cast<int32_t>(seconds * c_DriftPpm * c_RtcTimestampFractionsPerSecond / 1000000.0f);
+        RtcTimestamp reference(c_Start + seconds, 1000);
+        RtcTimestamp measured(c_Start + seconds, 1000 + 2000 + gained + noise);
+
+        // only half the window, then a reset
+        if (seconds == c_WindowSeconds / 2) {
+            CalibrationStore store(eeprom);
+            store.Begin();
+            RtcAgingCalibration<RtcDS3231<SimulatedTwoWire>, CalibrationStore> restored(rtc, store, c_WindowSeconds);
+            PrintlnCheck("samples survive a reset", restored.Begin() && restored.SampleCount() == samples &&
+                restored.DriftPpm() == calibration.DriftPpm() && !restored.IsReady());
+        }
+
+        // the samples since the last save are lost, the memory is written
+        // every c_RtcAgingSaveEverySamples samples
+        if (seconds == c_WindowSeconds / 2 + 3 * c_SampleSeconds) {
+            CalibrationStore store(eeprom);
+            store.Begin();
+            RtcAgingCalibration<RtcDS3231<SimulatedTwoWire>, CalibrationStore> restored(rtc, store, c_WindowSeconds);
+            PrintlnCheck("saved every few samples", restored.Begin() && samples % c_RtcAgingSaveEverySamples == 3 &&
+                restored.SampleCount() == samples - 3);
+        }
+
+        wire.Statistics.Reset();
+        uint32_t start = micros();
+        calibration.AddSample(reference, measured);
+        elapsedMicros += micros() - start;
+        samples++;
+    }
+    PrintlnPerIteration("AddSample", elapsedMicros, samples);
+    wire.Statistics.Reset();
+    calibration.Save();
+    PrintlnBusCost("Save", wire);
+
+    float drift = calibration.DriftPpm();
+    PrintlnCheck("drift by regression", calibration.IsReady() && drift > 2.45f && drift < 2.55f);
+    Serial.print("    drift ");
+    Serial.print(drift, 3);
+    Serial.println("ppm");
+
+    // 2.5ppm at 0.1ppm a step on top of the -3 already set
+    PrintlnCheck("aging offset applied", calibration.Apply() && rtc.GetAgingOffset() == 22 &&
+        device.Registers[0x10] == 22 && calibration.SampleCount() == 0);
+
+    CalibrationStore reloaded(eeprom);
+    reloaded.Begin();
+    RtcAgingCalibration<RtcDS3231<SimulatedTwoWire>, CalibrationStore> fresh(rtc, reloaded, c_WindowSeconds);
+    fresh.Begin();
+    PrintlnCheck("new window after apply", fresh.SampleCount() == 0 && !fresh.Apply() && rtc.GetAgingOffset() == 22);
+
+    Serial.println();
+}
+
+// a DS1307 whose seconds follow micros(), writing the seconds restarts the
+// second as on the real chip
+class TickingDs1307 : public SimulatedDs1307
+{
+public:
+    TickingDs1307() :
+        SetMicros(micros())
+    {
+    }
+
+    uint8_t OnWrite(const uint8_t* pData, uint8_t count)
+    {
+        if (count > 1 && pData[0] == 0x00)
+            SetMicros = micros();
+        return SimulatedDs1307::OnWrite(pData, count);
+    }
+
+    uint8_t OnRead(uint8_t* pData, uint8_t count)
+    {
+        while (micros() - SetMicros >= 1000000) {
+            AdvanceSeconds(1);
+            SetMicros += 1000000;
+        }
+        return SimulatedDs1307::OnRead(pData, count);
+    }
+
+    uint32_t SetMicros;
+};
+
+// stands in for RtcTickClock on the square wave of the ticking DS1307
+class TickingDs1307Clock
+{
+public:
+    TickingDs1307Clock(TickingDs1307& device, RtcDS1307<SimulatedTwoWire>& rtc) :
+        _device(device),
+        _rtc(rtc)
+    {
+    }
+
+    uint32_t NowSeconds(uint32_t* pMicroseconds) const
+    {
+        uint32_t seconds = _rtc.GetDateTime().TotalSeconds();
+
+        *pMicroseconds = micros() - _device.SetMicros;
+        return seconds;
+    }
+
+private:
+    TickingDs1307& _device;
+    RtcDS1307<SimulatedTwoWire>& _rtc;
+};
+
+static void DriftModelBenchmarks()
+{
+    Serial.println("Temperature drift model:");
+
+    const RtcDateTime now(2024, 2, 29, 12, 34, 56);
+    // far steeper than a real crystal so the drift shows within a second,
+    // -600000ppm at 45C
+    const float c_SteepPpmPerC2 = -1500.0f;
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs1307 device;
+        wire.Attach(device);
+        RtcDS1307<SimulatedTwoWire> rtc(wire);
+        RtcDriftModel<RtcDS1307<SimulatedTwoWire>> model(rtc);
+
+        float hot = model.DriftPpm(RtcTemperature(4500));
+        PrintlnCheck("parabolic tempco", model.DriftPpm(RtcTemperature(2500)) == 0.0f &&
+            hot > -13.61f && hot < -13.59f && model.DriftPpm(RtcTemperature(500)) == hot);
+
+        const uint16_t c_Predictions = 1000;
+        uint32_t start = micros();
+        for (uint16_t index = 0; index < c_Predictions; index++)
+            model.AddTemperature(RtcTemperature(index));
+        PrintlnPerIteration("AddTemperature", micros() - start, c_Predictions);
+    }
+
+    // the RTC second and the write back are checked to the microsecond, so
+    // the host runs them on simulated time
+    BenchmarkSimulateTime(true);
+
+    SimulatedTwoWire wire;
+    TickingDs1307 device;
+    wire.Attach(device);
+    wire.SetRealTimeLatency(true);
+    RtcDS1307<SimulatedTwoWire> rtc(wire);
+    rtc.SetIsRunning(true);
+    rtc.SetDateTime(now);
+
+    RtcDriftModel<RtcDS1307<SimulatedTwoWire>> model(rtc, 0.0f, c_RtcCrystalTurnoverC, c_SteepPpmPerC2);
+
+    // from 25C to 45C the drift is the mean of 0 and -600000ppm
+    model.AddTemperature(RtcTemperature(2500));
+    delay(100);
+    model.AddTemperature(RtcTemperature(4500));
+    int32_t error = model.ErrorMicros();
+    PrintlnCheck("drift integrated", error < -28000 && error > -34000);
+    PrintlnCheck("small error not written back", !model.WriteBack());
+
+    wire.Statistics.Reset();
+    delay(900);
+    model.AddTemperature(RtcTemperature(4500));
+    error = model.ErrorMicros();
+    PrintlnBusCost("AddTemperature", wire);
+
+    // the RTC has fallen more than half a second behind
+    RtcDateTime rtcNow = rtc.GetDateTime();
+    PrintlnCheck("corrected time", error < -500000 && model.GetDateTime() == RtcDateTime(rtcNow.TotalSeconds() + 1));
+
+    wire.Statistics.Reset();
+    uint32_t edgeMicros = device.SetMicros + 1000000;
+    uint32_t start = micros();
+    bool isWritten = model.WriteBack();
+    uint32_t elapsed = micros() - start;
+
+    // the next RTC second starts behind the true one by the error, the
+    // edge is found to within half the poll
+    const int32_t c_PolledTolerance = c_RtcDriftAlignPollMs * 500 + 2000;
+    int32_t phase = device.SetMicros - edgeMicros;
+    PrintlnCheck("written back at the true second", isWritten && model.ErrorMicros() == 0 &&
+        phase > 1000000 + error - c_PolledTolerance && phase < 1000000 + error + c_PolledTolerance &&
+        rtc.GetDateTime() == RtcDateTime(rtcNow.TotalSeconds() + 2));
+    PrintlnPerIteration("WriteBack", elapsed, 1);
+    PrintlnBusCost("WriteBack", wire);
+
+    // the edge from the square wave, the RTC is not polled for it
+    TickingDs1307Clock clock(device, rtc);
+    delay(600);
+    model.AddTemperature(RtcTemperature(4500));
+    error = model.ErrorMicros();
+    rtcNow = rtc.GetDateTime();
+    edgeMicros = device.SetMicros;
+
+    wire.Statistics.Reset();
+    start = micros();
+    isWritten = model.WriteBack(clock);
+    elapsed = micros() - start;
+
+    // the true second is error past an RTC edge, whichever one the write
+    // was in time for
+    int32_t expected = (error % 1000000 + 1000000) % 1000000;
+    phase = (static_cast<uint32_t>(device.SetMicros - edgeMicros) % 1000000);
+    int32_t miss = phase - expected;
+    if (miss > 500000) miss -= 1000000;
+    if (miss < -500000) miss += 1000000;
+    PrintlnCheck("written back from the tick", isWritten && model.ErrorMicros() == 0 &&
+        error < -500000 && miss > -2000 && miss < 2000);
+    PrintlnPerIteration("WriteBack from the tick", elapsed, 1);
+    PrintlnBusCost("WriteBack from the tick", wire);
+
+    BenchmarkSimulateTime(false);
+
+    Serial.println();
+}
+
+void CalibrationBenchmarks()
+{
+    AgingCalibrationBenchmarks();
+    DriftModelBenchmarks();
+}
@@ -0,0 +1,238 @@
+#include <Arduino.h>
+#include <RtcDS3231.h>
+#include <RtcClock.h>
+#include <RtcTickClock.h>
+#include <Rtc32kHzCapture.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+
+static void SoftwareClockBenchmarks()
+{
+    Serial.println("Software clock:");
+
+    const uint16_t c_Reads = 1000;
+    const RtcDateTime now(2024, 2, 29, 12, 34, 56);
+
+    SimulatedTwoWire wire;
+    SimulatedDs3231 device;
+    wire.Attach(device);
+    RtcDS3231<SimulatedTwoWire> rtc(wire);
+    rtc.SetDateTime(now);
+    wire.Statistics.Reset();
+
+    uint32_t sum = 0;
+    uint32_t start = micros();
+    for (uint16_t index = 0; index < c_Reads; index++)
+        sum += rtc.GetDateTime().Second();
+    PrintlnPerIteration("RtcDS3231 GetDateTime", micros() - start, c_Reads);
+    PrintlnBusCost("RtcDS3231 GetDateTime x 1000", wire);
+
+    // the simulated RTC does not tick, so it is not aligned to
+    RtcClock<RtcDS3231<SimulatedTwoWire>> clock(rtc, 50);
+    clock.Begin(false);
+    wire.Statistics.Reset();
+
+    start = micros();
+    for (uint16_t index = 0; index < c_Reads; index++)
+        sum += clock.NowSeconds();
+    PrintlnPerIteration("RtcClock NowSeconds", micros() - start, c_Reads);
+
+    start = micros();
+    for (uint16_t index = 0; index < c_Reads; index++)
+        sum += clock.Now().Second();
+    PrintlnPerIteration("RtcClock Now", micros() - start, c_Reads);
+    PrintlnBusCost("RtcClock x 2000", wire);
+    benchmarkSink = sum;
+
+    PrintlnCheck("RtcClock follows millis", clock.NowSeconds() == now.TotalSeconds());
+
+    // the resyncs below are checked to the millisecond
+    BenchmarkSimulateTime(true);
+
+    // the RTC moves ahead of the software clock, the next resync moves
+    // the software clock to the start of the RTC second
+    device.AdvanceSeconds(3);
+    delay(60);
+    uint16_t milliseconds;
+    uint32_t seconds = clock.NowSeconds(&milliseconds);
+    PrintlnCheck("RtcClock resync", seconds == now.TotalSeconds() + 3 && milliseconds < 10 &&
+        clock.LastCorrection() > 2000 && clock.LastCorrection() <= 3000);
+
+    // the RTC falls behind the software clock, which is held rather than
+    // moved back
+    uint32_t before = seconds * 1000 + milliseconds;
+    rtc.SetDateTime(RtcDateTime(now.TotalSeconds() + 1));
+    delay(60);
+    seconds = clock.NowSeconds(&milliseconds);
+    PrintlnCheck("RtcClock held", seconds * 1000 + milliseconds >= before &&
+        clock.LastCorrection() < -1000 && clock.LastCorrection() >= -2000);
+    uint16_t heldMilliseconds = milliseconds;
+    delay(60);
+    PrintlnCheck("RtcClock held until caught up", clock.NowSeconds(&milliseconds) == seconds &&
+        milliseconds == heldMilliseconds);
+
+    // the RTC set far away is taken as is
+    rtc.SetDateTime(RtcDateTime(2030, 1, 1, 0, 0, 0));
+    delay(60);
+    PrintlnCheck("RtcClock RTC set", clock.Now() == RtcDateTime(2030, 1, 1, 0, 0, 0));
+
+    // a failed read is not taken as the RTC having been set, the time is
+    // kept and the very next NowSeconds() reads the RTC again
+    const RtcDateTime set(2030, 1, 1, 0, 0, 0);
+    device.AdvanceSeconds(3);
+    wire.FailTransactions = 1;
+    delay(60);
+    PrintlnCheck("RtcClock keeps time on a failed read", clock.Now() == set);
+    PrintlnCheck("RtcClock resync after a failed read",
+        clock.Now() == RtcDateTime(set.TotalSeconds() + 3));
+
+    wire.FailTransactions = 1;
+    PrintlnCheck("RtcClock Sync with a failed read", !clock.Sync(false) &&
+        clock.Now() == RtcDateTime(set.TotalSeconds() + 3));
+
+    BenchmarkSimulateTime(false);
+
+    Serial.println();
+}
+
+static RtcTickClock s_tickClock;
+
+static void ISR_ATTR OnSecondTick()
+{
+    s_tickClock.Tick();
+}
+
+static void TickClockBenchmarks()
+{
+    Serial.println("Square wave tick clock:");
+
+    const uint16_t c_Reads = 1000;
+    const RtcDateTime now(2024, 2, 29, 12, 34, 56);
+
+    SimulatedTwoWire wire;
+    SimulatedDs3231 device;
+    wire.Attach(device);
+    RtcDS3231<SimulatedTwoWire> rtc(wire);
+    rtc.SetDateTime(now);
+    rtc.SetSquareWavePinClockFrequency(DS3231SquareWaveClock_1Hz);
+    rtc.SetSquareWavePin(DS3231SquareWavePin_ModeClock);
+    wire.Statistics.Reset();
+
+    s_tickClock.Begin(rtc);
+    PrintlnBusCost("Begin", wire);
+
+    uint32_t sum = 0;
+    uint32_t start = micros();
+    for (uint16_t index = 0; index < c_Reads; index++)
+        sum += s_tickClock.NowSeconds();
+    PrintlnPerIteration("NowSeconds", micros() - start, c_Reads);
+
+    uint32_t microseconds;
+    start = micros();
+    for (uint16_t index = 0; index < c_Reads; index++)
+        sum += s_tickClock.NowSeconds(&microseconds);
+    PrintlnPerIteration("NowSeconds with microseconds", micros() - start, c_Reads);
+    PrintlnBusCost("NowSeconds x 2000", wire);
+    benchmarkSink = sum;
+
+    // the interrupt for each falling edge of the square wave
+    for (uint8_t tick = 0; tick < 5; tick++)
+        OnSecondTick();
+    uint32_t seconds = s_tickClock.NowSeconds(&microseconds);
+    PrintlnCheck("ticks", seconds == now.TotalSeconds() + 5 && microseconds < 1000 &&
+        s_tickClock.Now() == RtcDateTime(now.TotalSeconds() + 5));
+
+    Serial.println();
+}
+
+// stands in for a hardware counter of the 32kHz edges
+class SimulatedEdgeCounter
+{
+public:
+    SimulatedEdgeCounter() :
+        Count(0)
+    {
+    }
+
+    void Begin()
+    {
+    }
+
+    uint16_t Read()
+    {
+        return Count;
+    }
+
+    uint16_t Count;
+};
+
+static void SubSecondBenchmarks()
+{
+    Serial.println("32kHz sub-second timestamps:");
+
+    const uint16_t c_Captures = 1000;
+    const RtcDateTime now(2024, 2, 29, 12, 34, 56);
+
+    PrintlnCheck("RtcTimestamp fractions", RtcTimestamp(0, 16384).Microseconds() == 500000 &&
+        RtcTimestamp(0, 1).Microseconds() == 30 && RtcTimestamp(0, 32767).Milliseconds() == 999 &&
+        RtcTimestamp(10, 32768 + 5) == RtcTimestamp(11, 5) &&
+        RtcTimestamp(11, 5) - RtcTimestamp(10, 32000) == 773 && RtcTimestamp(10, 32000) < RtcTimestamp(11, 5));
+
+    SimulatedTwoWire wire;
+    SimulatedDs3231 device;
+    wire.Attach(device);
+    RtcDS3231<SimulatedTwoWire> rtc(wire);
+    rtc.SetDateTime(now);
+    rtc.Enable32kHzPin(true);
+    wire.Statistics.Reset();
+
+    SimulatedEdgeCounter counter;
+    Rtc32kHzCapture<SimulatedEdgeCounter> capture(counter);
+
+    // the counter runs freely, so it is not zero at the first tick
+    counter.Count = 12345;
+    capture.Begin(rtc);
+    bool isUnlocked = !capture.IsLocked() && capture.Capture() == RtcTimestamp(now.TotalSeconds());
+
+    counter.Count += 20000;
+    capture.Tick();
+    counter.Count += 32768;
+    capture.Tick();
+    PrintlnCheck("locked to the second tick", isUnlocked && capture.IsLocked());
+
+    counter.Count += 1000;
+    RtcTimestamp stamp = capture.Capture();
+    PrintlnCheck("fraction from the 32kHz count", stamp.TotalSeconds() == now.TotalSeconds() + 2 &&
+        stamp.Fraction() == 1000 && stamp.Microseconds() == 30517);
+
+    // the edge of the next second happened but its interrupt has not run
+    counter.Count += 31768 + 7;
+    stamp = capture.Capture();
+    PrintlnCheck("pending tick", stamp.TotalSeconds() == now.TotalSeconds() + 3 && stamp.Fraction() == 7);
+
+    counter.Count -= 7;
+    capture.Tick();
+    counter.Count += 32000;
+    capture.Tick();
+    PrintlnCheck("missed edges unlock", !capture.IsLocked());
+
+    wire.Statistics.Reset();
+    uint32_t sum = 0;
+    uint32_t start = micros();
+    for (uint16_t index = 0; index < c_Captures; index++)
+        sum += capture.Capture().Fraction();
+    PrintlnPerIteration("Capture", micros() - start, c_Captures);
+    PrintlnBusCost("Capture x 1000", wire);
+    benchmarkSink = sum;
+
+    Serial.println();
+}
+
+void ClockBenchmarks()
+{
+    SoftwareClockBenchmarks();
+    TickClockBenchmarks();
+    SubSecondBenchmarks();
+}
@@ -0,0 +1,204 @@
+#include <Arduino.h>
+#include <RtcDateTimeArray.h>
+#include <RtcUtility.h>
+
+#include "RtcBenchmarkHelpers.h"
+
+const uint8_t c_ArrayCount = 32;
+
+static void DateConversionBenchmarks()
+{
+    Serial.println("Date conversion:");
+
+    // the cost of a conversion should not depend on how far the
+    // time is from 2000
+    const uint16_t years[] = { 2000, 2038, 2099, 2135 };
+
+    for (uint8_t index = 0; index < sizeof(years) / sizeof(years[0]); ++index)
+    {
+        RtcDateTime origin(years[index], 7, 15, 12, 30, 45);
+        uint32_t seconds = origin.TotalSeconds();
+
+        uint32_t start = micros();
+        for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+        {
+            RtcDateTime converted(seconds + iteration);
+            benchmarkSink = converted.Day();
+        }
+        uint32_t elapsed = micros() - start;
+
+        Serial.print(years[index]);
+        PrintlnPerIteration(" RtcDateTime(uint32_t)", elapsed, c_ConversionIterations);
+    }
+
+    const uint64_t epochs[] = { 946684800ULL, 4102444800ULL, 7258118400ULL, 8835955200ULL };
+
+    for (uint8_t index = 0; index < sizeof(epochs) / sizeof(epochs[0]); ++index)
+    {
+        RtcDateTime converted;
+
+        uint32_t start = micros();
+        for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+        {
+            converted.InitWithEpoch64Time(epochs[index] + iteration);
+            benchmarkSink = converted.Day();
+        }
+        uint32_t elapsed = micros() - start;
+
+        Serial.print(converted.Year());
+        PrintlnPerIteration(" InitWithEpoch64Time", elapsed, c_ConversionIterations);
+    }
+
+    {
+        RtcDateTime converted(2000, 1, 1, 0, 0, 0);
+
+        uint32_t start = micros();
+        for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+        {
+            converted += 86399;
+        }
+        uint32_t elapsed = micros() - start;
+        benchmarkSink = converted.Day();
+
+        PrintlnPerIteration("operator+=", elapsed, c_ConversionIterations);
+    }
+
+    // round trip every day from 2000 through 2135, this covers
+    // leap years and the non leap year of 2100
+    {
+        bool passed = true;
+        uint32_t seconds = 0;
+
+        for (uint32_t day = 0; day < 49710; ++day, seconds += 86400)
+        {
+            RtcDateTime converted(seconds + 43200);
+            if (converted.TotalSeconds() != seconds + 43200 ||
+                converted.TotalDays() != day)
+            {
+                passed = false;
+                break;
+            }
+        }
+
+        Serial.print("round trip ");
+        PrintPassFail(passed);
+        Serial.println();
+
+        RtcDateTime notLeapDay(2100, 2, 28, 0, 0, 0);
+        notLeapDay += 86400;
+
+        Serial.print("2100 is not a leap year ");
+        PrintPassFail(notLeapDay.Month() == 3 && notLeapDay.Day() == 1);
+        Serial.println();
+    }
+
+    Serial.println();
+}
+
+static void DateArrayBenchmarks()
+{
+    Serial.println("Date array conversion:");
+
+    uint32_t seconds[c_ArrayCount];
+    uint32_t roundTrip[c_ArrayCount];
+    RtcDateTime dateTimes[c_ArrayCount];
+
+    // spread over the whole 32-bit range
+    for (uint8_t index = 0; index < c_ArrayCount; ++index)
+    {
+        seconds[index] = (uint32_t)index * 134217727UL + index * 3607UL;
+    }
+
+    const uint16_t iterations = c_ConversionIterations / c_ArrayCount;
+    uint32_t start = micros();
+    for (uint16_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        for (uint8_t index = 0; index < c_ArrayCount; ++index)
+        {
+            dateTimes[index] = RtcDateTime(seconds[index] + iteration);
+        }
+        benchmarkSink = dateTimes[iteration % c_ArrayCount].Day();
+    }
+    uint32_t elapsed = micros() - start;
+    PrintlnPerIteration("RtcDateTime(uint32_t) loop", elapsed, iterations * c_ArrayCount);
+
+    start = micros();
+    for (uint16_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        seconds[0] += 1;
+        RtcDateTimesFromSeconds(dateTimes, seconds, c_ArrayCount);
+        benchmarkSink = dateTimes[iteration % c_ArrayCount].Day();
+    }
+    elapsed = micros() - start;
+    PrintlnPerIteration("RtcDateTimesFromSeconds", elapsed, iterations * c_ArrayCount);
+
+    start = micros();
+    for (uint16_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        RtcDateTimesToSeconds(roundTrip, dateTimes, c_ArrayCount);
+        benchmarkSink = roundTrip[iteration % c_ArrayCount];
+    }
+    elapsed = micros() - start;
+    PrintlnPerIteration("RtcDateTimesToSeconds", elapsed, iterations * c_ArrayCount);
+
+    bool passed = true;
+    for (uint8_t index = 0; index < c_ArrayCount; ++index)
+    {
+        RtcDateTime single(seconds[index]);
+        if (single.TotalSeconds() != dateTimes[index].TotalSeconds() ||
+            roundTrip[index] != seconds[index])
+        {
+            passed = false;
+        }
+    }
+    Serial.print("matches single conversion ");
+    PrintPassFail(passed);
+    Serial.println();
+
+    Serial.println();
+}
+
+static void BcdBenchmarks()
+{
+    Serial.println("BCD conversion:");
+
+    uint32_t start = micros();
+    for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+    {
+        benchmarkSink = BcdToUint8(Uint8ToBcd(iteration % 100));
+    }
+    uint32_t elapsed = micros() - start;
+    PrintlnPerIteration("Uint8ToBcd + BcdToUint8", elapsed, c_ConversionIterations);
+
+    start = micros();
+    for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+    {
+        // alternate 12 hour PM and 24 hour formats
+        uint8_t bcdHour = (iteration & 1) ? (0x60 | Uint8ToBcd(iteration % 12 + 1)) : Uint8ToBcd(iteration % 24);
+        benchmarkSink = BcdToBin24Hour(bcdHour);
+    }
+    elapsed = micros() - start;
+    PrintlnPerIteration("Uint8ToBcd + BcdToBin24Hour", elapsed, c_ConversionIterations);
+
+    bool passed = true;
+    for (uint8_t value = 0; value < 100; ++value)
+    {
+        if (BcdToUint8(Uint8ToBcd(value)) != value ||
+            Uint8ToBcd(value) != ((value / 10) << 4 | (value % 10)))
+        {
+            passed = false;
+        }
+    }
+    Serial.print("round trip ");
+    PrintPassFail(passed);
+    Serial.println();
+
+    Serial.println();
+}
+
+void DateTimeBenchmarks()
+{
+    DateConversionBenchmarks();
+    DateArrayBenchmarks();
+    BcdBenchmarks();
+}
@@ -0,0 +1,166 @@
+#include <Arduino.h>
+#include <EepromAT24C32.h>
+#include <EepromAT24C32EventLog.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedAt24c32.h"
+
+static uint16_t s_rangeFound;
+static bool s_isRangeInOrder;
+
+static void CheckRangeRecord(uint32_t sequence, const RtcDateTime& time, const uint8_t* pPayload)
+{
+    s_isRangeInOrder &= (pPayload[0] == (uint8_t)sequence) && (time.TotalSeconds() % 60 == 0);
+    s_rangeFound++;
+}
+
+void EventLogBenchmarks()
+{
+    Serial.println("AT24C32 event log:");
+
+    SimulatedTwoWire wire;
+    SimulatedAt24c32 device;
+    wire.Attach(device);
+    wire.SetRealTimeLatency(true);
+    EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+
+    const RtcDateTime origin(2024, 1, 1, 0, 0, 0);
+    const uint16_t c_Events = 150;
+
+    {
+        // 64 records of 16 bytes after a 32 byte region left for settings
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> log(eeprom, 32, 1024);
+
+        log.Format();
+        eeprom.GetMemory(0); // the last write cycle
+        wire.Statistics.Reset();
+        device.PageWrites = 0;
+
+        uint32_t start = micros();
+        for (uint16_t event = 0; event < c_Events; event++) {
+            uint8_t payload[] = { (uint8_t)event, 0x42 };
+            log.Append(RtcDateTime(origin.TotalSeconds() + event * 60), payload, sizeof(payload));
+        }
+        eeprom.GetMemory(0);
+        PrintlnPerIteration("Append", micros() - start, c_Events);
+        PrintlnCheck("one page write per append", device.PageWrites == c_Events);
+        wire.Statistics.Reset();
+    }
+
+    {
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> log(eeprom, 32, 1024);
+
+        log.Begin();
+        PrintlnBusCost("Begin, 64 records", wire);
+        PrintlnCheck("recovered head and tail", log.Count() == 64 && 
+            log.FirstSequence() == c_Events - 64 && log.NextSequence() == c_Events);
+
+        RtcDateTime time;
+        uint8_t payload[log.PayloadSize];
+        PrintlnCheck("oldest record", log.GetRecord(c_Events - 64, &time, payload) && 
+            payload[0] == c_Events - 64 && payload[1] == 0x42 && payload[2] == 0xff &&
+            time.TotalSeconds() == origin.TotalSeconds() + (c_Events - 64) * 60);
+        PrintlnCheck("overwritten record", !log.GetRecord(c_Events - 65, &time, payload));
+
+        // 10 minutes, inclusive of both ends so 11 records
+        s_rangeFound = 0;
+        s_isRangeInOrder = true;
+        RtcDateTime from(origin.TotalSeconds() + 100 * 60 - 30);
+        RtcDateTime to(origin.TotalSeconds() + 110 * 60);
+        uint16_t found = log.ForEachInRange(from, to, CheckRangeRecord);
+        PrintlnBusCost("ForEachInRange 11 records", wire);
+        PrintlnCheck("time range", found == 11 && s_rangeFound == 11 && s_isRangeInOrder &&
+            log.FindSequence(from) == 100);
+
+        // appending after recovery continues the sequence in place
+        uint8_t more[] = { (uint8_t)c_Events, 0x42 };
+        log.Append(RtcDateTime(origin.TotalSeconds() + c_Events * 60), more, sizeof(more));
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> again(eeprom, 32, 1024);
+        again.Begin();
+        PrintlnCheck("append after recovery", again.Count() == 64 && again.NextSequence() == c_Events + 1 &&
+            device.Memory[0] == 0xff);
+    }
+
+    {
+        // wrap the head round to slot 0, 192 then goes over 128 there
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> log(eeprom, 32, 1024);
+
+        log.Begin();
+        for (uint32_t event = log.NextSequence(); event < 192; event++) {
+            uint8_t payload[] = { (uint8_t)event, 0x42 };
+            log.Append(RtcDateTime(origin.TotalSeconds() + event * 60), payload, sizeof(payload));
+        }
+        eeprom.GetMemory(0);
+
+        // the sequence of 192 written over the time of 128
+        uint8_t* pSlot = &device.Memory[32];
+        pSlot[0] = 192;
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> torn(eeprom, 32, 1024);
+        wire.Statistics.Reset();
+        bool isBegun = torn.Begin();
+        PrintlnBusCost("Begin, torn append", wire);
+
+        RtcDateTime time;
+        uint8_t payload[log.PayloadSize];
+        PrintlnCheck("torn append time", isBegun && torn.NextSequence() == 192 && torn.Count() == 63 &&
+            torn.GetRecord(191, &time, payload) && payload[0] == 191);
+
+        // the slot erased but not yet written
+        memset(pSlot, 0xff, 16);
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> erased(eeprom, 32, 1024);
+        PrintlnCheck("torn append erased", erased.Begin() && erased.NextSequence() == 192 &&
+            erased.Count() == 63 && !erased.GetRecord(128, &time, payload));
+
+        // appending over the torn slot restores a full log
+        uint8_t more[] = { 192, 0x42 };
+        erased.Append(RtcDateTime(origin.TotalSeconds() + 192 * 60), more, sizeof(more));
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> again(eeprom, 32, 1024);
+        PrintlnCheck("append after torn append", again.Begin() && again.NextSequence() == 193 &&
+            again.Count() == 64);
+    }
+
+    {
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> log(eeprom, 0, 8);
+        uint8_t payload[] = { 1 };
+
+        PrintlnCheck("region smaller than a record", !log.Begin() && !log.Format() &&
+            !log.Append(origin, payload, sizeof(payload)) && log.Capacity() == 0);
+
+        EepromAt24c32EventLog<SimulatedTwoWire, 16> unaligned(eeprom, 16, 1024);
+
+        PrintlnCheck("region off a page boundary", !unaligned.Begin() && !unaligned.Format() &&
+            !unaligned.Append(origin, payload, sizeof(payload)) && unaligned.Capacity() == 0);
+    }
+
+    {
+        EepromAt24c32EventLog<SimulatedTwoWire, 32> log(eeprom, 2048, 256);
+
+        log.Format();
+        log.Begin();
+        bool isEmpty = (log.Count() == 0);
+
+        uint8_t payload[] = { 1 };
+        for (uint8_t event = 0; event < 5; event++)
+            log.Append(origin, payload, sizeof(payload));
+
+        EepromAt24c32EventLog<SimulatedTwoWire, 32> again(eeprom, 2048, 256);
+        again.Begin();
+        PrintlnCheck("partly filled log", isEmpty && again.Count() == 5 && again.NextSequence() == 5);
+
+        // a 32 byte record is two write cycles, the second one lost leaves
+        // the new header over the erased end of the payload
+        uint8_t full[log.PayloadSize];
+        memset(full, 0x11, sizeof(full));
+        again.Append(origin, full, sizeof(full));
+        eeprom.GetMemory(0);
+        memset(&device.Memory[2048 + 5 * 32 + 30], 0xff, 2);
+
+        EepromAt24c32EventLog<SimulatedTwoWire, 32> torn(eeprom, 2048, 256);
+        RtcDateTime time;
+        PrintlnCheck("torn 32 byte append", torn.Begin() && torn.Count() == 5 && torn.NextSequence() == 5 &&
+            !again.GetRecord(5, &time, full));
+    }
+
+    Serial.println();
+}
@@ -0,0 +1,288 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <RtcDS3234.h>
+#include <EepromAT24C32.h>
+#include <EepromAT24C32Cache.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedAt24c32.h"
+
+template<typename T_BUS> void PrintlnThroughput(const char* name, uint32_t elapsedMicros, uint16_t bytes, T_BUS& bus)
+{
+    Serial.print(name);
+    Serial.print(" ");
+    Serial.print((float)bytes * 1000 / elapsedMicros, 1);
+    Serial.print("KB/s, bus ");
+    Serial.print((float)bytes * 1000 / bus.Statistics.busMicros, 1);
+    Serial.print("KB/s in ");
+    Serial.print(bus.Statistics.transactions);
+    Serial.println(" transactions");
+
+    bus.Statistics.Reset();
+}
+
+static void Ds3234MemoryBenchmarks()
+{
+    Serial.println("DS3234 SRAM throughput:");
+
+    SimulatedDs3234 spi;
+    RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+    uint8_t memory[256];
+
+    for (uint16_t index = 0; index < sizeof(memory); index++)
+        memory[index] = index * 7;
+
+    uint32_t start = micros();
+    rtc.SetMemory(0, memory, sizeof(memory));
+    PrintlnThroughput("SetMemory 256", micros() - start, sizeof(memory), spi);
+
+    bool isWritten = (memcmp(spi.Ram, memory, sizeof(memory)) == 0);
+    memset(memory, 0, sizeof(memory));
+
+    start = micros();
+    rtc.GetMemory(0, memory, sizeof(memory));
+    PrintlnThroughput("GetMemory 256", micros() - start, sizeof(memory), spi);
+
+    PrintlnCheck("SRAM round trip", isWritten && (memcmp(spi.Ram, memory, sizeof(memory)) == 0));
+
+    // the address wraps
+    uint8_t wrapped[4] = { 1, 2, 3, 4 };
+    rtc.SetMemory(0xfe, wrapped, sizeof(wrapped));
+    PrintlnCheck("SRAM address wrap", spi.Ram[0xfe] == 1 && spi.Ram[0xff] == 2 && spi.Ram[0x00] == 3 && spi.Ram[0x01] == 4);
+
+    Serial.println();
+}
+
+static void EepromWriteBenchmarks()
+{
+    Serial.println("AT24C32 page writes:");
+
+    SimulatedTwoWire wire;
+    SimulatedAt24c32 device;
+    wire.Attach(device);
+    // the acknowledge polls take their bus time
+    wire.SetRealTimeLatency(true);
+    EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+    uint8_t memory[1024];
+
+    for (uint16_t index = 0; index < sizeof(memory); index++)
+        memory[index] = index * 13;
+
+    // not page aligned, so the first and last pages are partial
+    const uint16_t address = 100;
+
+    uint32_t start = micros();
+    uint16_t written = eeprom.SetMemory(address, memory, sizeof(memory));
+    PrintlnThroughput("SetMemory 1024", micros() - start, sizeof(memory), wire);
+
+    // the Wire buffer limits each write to 30 bytes, so most pages take two
+    Serial.print("page writes ");
+    Serial.print(device.PageWrites);
+    Serial.print(", fixed 10ms delays would take ");
+    Serial.print(device.PageWrites * 10);
+    Serial.println("ms");
+
+    bool isWritten = (written == sizeof(memory)) &&
+        (memcmp(device.Memory + address, memory, sizeof(memory)) == 0);
+    PrintlnCheck("SetMemory across pages", isWritten);
+
+    uint8_t read[32];
+    bool isRead = true;
+    for (uint16_t offset = 0; offset < sizeof(memory); offset += sizeof(read)) {
+        isRead &= (eeprom.GetMemory(address + offset, read, sizeof(read)) == sizeof(read)) &&
+            (memcmp(read, memory + offset, sizeof(read)) == 0);
+    }
+    PrintlnCheck("GetMemory after write cycle", isRead && eeprom.LastError() == 0);
+    wire.Statistics.Reset();
+
+    Serial.println();
+}
+
+static uint16_t s_streamSum;
+
+static void SumChunk(const uint8_t* pValue, uint8_t countBytes)
+{
+    while (countBytes--)
+        s_streamSum += *pValue++;
+}
+
+static void EepromReadBenchmarks()
+{
+    Serial.println("AT24C32 reads:");
+
+    SimulatedTwoWire wire;
+    SimulatedAt24c32 device;
+    wire.Attach(device);
+    EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+    uint8_t memory[1024];
+    uint16_t sum = 0;
+
+    for (uint16_t index = 0; index < c_SimulatedAt24c32Size; index++) {
+        device.Memory[index] = index * 13 + (index >> 8);
+        sum += device.Memory[index];
+    }
+
+    // one call in place of a loop of 32 byte reads
+    uint32_t start = micros();
+    uint16_t read = eeprom.GetMemory(100, memory, sizeof(memory));
+    PrintlnThroughput("GetMemory 1024", micros() - start, sizeof(memory), wire);
+    PrintlnCheck("GetMemory 1024", read == sizeof(memory) && 
+        memcmp(memory, device.Memory + 100, sizeof(memory)) == 0);
+
+    // sequential calls continue without sending the address again
+    start = micros();
+    read = 0;
+    for (uint16_t offset = 0; offset < sizeof(memory); offset += 32)
+        read += eeprom.GetMemory(1124 + offset, memory + offset, 32);
+    PrintlnThroughput("GetMemory 32 x 32 sequential", micros() - start, sizeof(memory), wire);
+    PrintlnCheck("GetMemory sequential", read == sizeof(memory) && 
+        memcmp(memory, device.Memory + 1124, sizeof(memory)) == 0);
+
+    // the whole image without a buffer for it
+    s_streamSum = 0;
+    start = micros();
+    read = eeprom.StreamMemory(0, c_SimulatedAt24c32Size, SumChunk);
+    PrintlnThroughput("StreamMemory 4096", micros() - start, c_SimulatedAt24c32Size, wire);
+    PrintlnCheck("StreamMemory 4096", read == c_SimulatedAt24c32Size && s_streamSum == sum);
+
+    // the device rolled over to the first byte, so that needs no address
+    wire.Statistics.Reset();
+    read = eeprom.GetMemory(0, memory, 16);
+    PrintlnCheck("GetMemory after roll over", read == 16 && wire.Statistics.transactions == 1 &&
+        memcmp(memory, device.Memory, 16) == 0);
+
+    // a failed write may have moved the device, the address is sent again
+    device.IsDataNacked = true;
+    eeprom.SetMemory(200, memory, 1);
+    device.IsDataNacked = false;
+    wire.Statistics.Reset();
+    read = eeprom.GetMemory(16, memory, 16);
+    PrintlnCheck("GetMemory after a failed write", read == 16 && wire.Statistics.transactions == 2 &&
+        memcmp(memory, device.Memory + 16, 16) == 0);
+
+    Serial.println();
+}
+
+// settings and counters updated a byte at a time, spread over three pages
+static void EepromScatteredUpdates(uint16_t iteration, uint16_t& address, uint8_t& value)
+{
+    address = 64 + (iteration % 3) * AT24C32_PAGE_SIZE + (iteration * 7) % AT24C32_PAGE_SIZE;
+    value = iteration;
+}
+
+static void EepromCacheBenchmarks()
+{
+    Serial.println("AT24C32 page cache:");
+
+    const uint16_t c_Updates = 300;
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        wire.SetRealTimeLatency(true);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+
+        uint32_t start = micros();
+        for (uint16_t iteration = 0; iteration < c_Updates; iteration++) {
+            uint16_t address;
+            uint8_t value;
+            EepromScatteredUpdates(iteration, address, value);
+            eeprom.SetMemory(address, value);
+        }
+        eeprom.GetMemory(0); // the last write cycle
+        PrintlnPerIteration("uncached SetMemory", micros() - start, c_Updates);
+
+        Serial.print("page writes ");
+        Serial.println(device.PageWrites);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        wire.SetRealTimeLatency(true);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+        EepromAt24c32Cache<SimulatedTwoWire, 4> cache(eeprom);
+        uint8_t expected[3 * AT24C32_PAGE_SIZE];
+
+        memset(expected, 0xff, sizeof(expected));
+
+        uint32_t start = micros();
+        for (uint16_t iteration = 0; iteration < c_Updates; iteration++) {
+            uint16_t address;
+            uint8_t value;
+            EepromScatteredUpdates(iteration, address, value);
+            cache.SetMemory(address, value);
+            expected[address - 64] = value;
+        }
+        cache.Flush();
+        eeprom.GetMemory(0); // the last write cycle
+        PrintlnPerIteration("cached SetMemory", micros() - start, c_Updates);
+
+        Serial.print("page writes ");
+        Serial.print(device.PageWrites);
+        Serial.print(", saved ");
+        Serial.print(cache.PageWritesSaved());
+        Serial.print(", hits ");
+        Serial.print(cache.CacheHits());
+        Serial.print(", misses ");
+        Serial.print(cache.CacheMisses());
+        Serial.print(", hit rate ");
+        Serial.print(100.0f * cache.CacheHits() / (cache.CacheHits() + cache.CacheMisses()), 1);
+        Serial.println("%");
+
+        PrintlnCheck("flushed updates", device.PageWrites == cache.PageWrites() && 
+            memcmp(device.Memory + 64, expected, sizeof(expected)) == 0);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+        EepromAt24c32Cache<SimulatedTwoWire, 2> cache(eeprom);
+
+        // a third page evicts the least recently used, which is written
+        cache.SetMemory(0, 1);
+        cache.SetMemory(32, 2);
+        cache.GetMemory(0);
+        cache.SetMemory(64, 3);
+        PrintlnCheck("LRU eviction writes back", device.PageWrites == 1 && 
+            cache.GetMemory(0) == 1 && cache.GetMemory(64) == 3);
+
+        // a write spanning pages, read back through the cache
+        const uint8_t data[] = { 5, 6, 7, 8 };
+        uint8_t read[sizeof(data)];
+        cache.SetMemory(94, data, sizeof(data));
+        cache.GetMemory(94, read, sizeof(read));
+        bool isCached = (memcmp(data, read, sizeof(data)) == 0);
+        cache.Flush();
+        PrintlnCheck("spanning write", isCached && eeprom.GetMemory(96) == 7 && eeprom.GetMemory(95) == 6);
+
+        // writing what is already there dirties nothing
+        uint32_t pageWrites = device.PageWrites;
+        cache.SetMemory(94, data, sizeof(data));
+        cache.Flush();
+        PrintlnCheck("unchanged write skipped", device.PageWrites == pageWrites);
+
+        // an address beyond the memory is the page it wraps to
+        cache.SetMemory(AT24C32_SIZE + 96, 9);
+        uint32_t misses = cache.CacheMisses();
+        bool isAliased = (cache.GetMemory(96) == 9 && cache.CacheMisses() == misses);
+        cache.Flush();
+        PrintlnCheck("aliased address", isAliased && eeprom.GetMemory(96) == 9);
+    }
+
+    Serial.println();
+}
+
+void MemoryBenchmarks()
+{
+    Ds3234MemoryBenchmarks();
+    EepromWriteBenchmarks();
+    EepromReadBenchmarks();
+    EepromCacheBenchmarks();
+}
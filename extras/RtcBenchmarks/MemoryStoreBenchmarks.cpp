@@ -0,0 +1,122 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <ThreeWire.h>
+#include <RtcDS1302.h>
+#include <RtcDS1307.h>
+#include <RtcDS3234.h>
+#include <RtcMemoryStore.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedDs1307.h"
+#include "SimulatedDs1302.h"
+
+struct StoreSettings
+{
+    uint16_t interval;
+    int8_t offset;
+    uint8_t flags;
+};
+
+template<typename T_STORE, typename T_BUS> void MemoryStoreChecks(const char* name, T_STORE& store, T_BUS& bus)
+{
+    StoreSettings settings = { 60, -3, 0x01 };
+    uint16_t counter = 1000;
+
+    store.Begin();
+    bool isEmpty = store.IsEmpty();
+    store.Set(1, (const uint8_t*)&settings, sizeof(settings));
+    store.Set(2, (const uint8_t*)&counter, sizeof(counter));
+    bus.Statistics.Reset();
+
+    // a single byte of the counter changes, against writing a whole bank
+    counter++;
+    store.Set(2, (const uint8_t*)&counter, sizeof(counter));
+    Serial.print(name);
+    PrintlnBusCost(" update", bus);
+    counter++;
+    store.Set(2, (const uint8_t*)&counter, sizeof(counter));
+    bus.Statistics.Reset();
+
+    StoreSettings read;
+    uint16_t readCounter = 0;
+    T_STORE again = store;
+    again.Begin();
+    bool isRead = (again.Get(1, (uint8_t*)&read, sizeof(read)) == sizeof(read)) &&
+        read.interval == 60 && read.offset == -3 &&
+        (again.Get(2, (uint8_t*)&readCounter, sizeof(readCounter)) == sizeof(readCounter)) &&
+        readCounter == counter && again.Get(3, (uint8_t*)&read, sizeof(read)) == 0;
+
+    Serial.print(name);
+    PrintlnCheck(" round trip", isEmpty && isRead);
+}
+
+void MemoryStoreBenchmarks()
+{
+    Serial.println("Memory store:");
+
+    const uint8_t crcCheck[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    PrintlnCheck("CRC-8/MAXIM", RtcCrc8(crcCheck, sizeof(crcCheck)) == 0xa1);
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs1307 device;
+        wire.Attach(device);
+        RtcDS1307<SimulatedTwoWire> rtc(wire);
+        RtcMemoryStore<RtcDS1307<SimulatedTwoWire>, 28> store(rtc);
+
+        MemoryStoreChecks("DS1307", store, wire);
+
+        // a reset part way through writing the newer value damages the bank
+        // it was written to, so the older value is kept
+        const uint8_t counterOffset = c_MemoryStoreHeaderSize + c_MemoryStoreEntryOverhead + sizeof(StoreSettings) + 2;
+        uint16_t counter = 0;
+        store.Get(2, (uint8_t*)&counter, sizeof(counter));
+        uint16_t newer = counter + 1;
+        store.Set(2, (const uint8_t*)&newer, sizeof(newer));
+
+        for (uint8_t bank = 0; bank < 2; bank++) {
+            uint8_t* pValue = device.Registers + DS1307_REG_RAMSTART + bank * 28 + counterOffset;
+            if (memcmp(pValue, &newer, sizeof(newer)) == 0)
+                pValue[0] ^= 0x10;
+        }
+
+        RtcMemoryStore<RtcDS1307<SimulatedTwoWire>, 28> torn(rtc);
+        torn.Begin();
+        uint16_t value = 0;
+        torn.Get(2, (uint8_t*)&value, sizeof(value));
+        PrintlnCheck("DS1307 torn bank falls back", value == counter);
+
+        store.Clear();
+        RtcMemoryStore<RtcDS1307<SimulatedTwoWire>, 28> cleared(rtc);
+        cleared.Begin();
+        PrintlnCheck("DS1307 clear", cleared.IsEmpty() && cleared.Available() == 26);
+    }
+
+    {
+        SimulatedDs1302 wire;
+        RtcDS1302<SimulatedDs1302> rtc(wire);
+        rtc.SetIsWriteProtected(false);
+        RtcMemoryStore<RtcDS1302<SimulatedDs1302>, 15> store(rtc);
+
+        MemoryStoreChecks("DS1302", store, wire);
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+        RtcMemoryStore<RtcDS3234<SimulatedDs3234>, 128> store(rtc);
+
+        MemoryStoreChecks("DS3234", store, spi);
+
+        uint8_t large[115];
+        memset(large, 0x5a, sizeof(large));
+        bool isTooLarge = !store.Set(9, large, sizeof(large));
+        store.Remove(1);
+        PrintlnCheck("DS3234 remove", isTooLarge && store.Set(9, large, sizeof(large)) &&
+            store.Get(1, large, 1) == 0 && store.Get(9, large, sizeof(large)) == sizeof(large));
+    }
+
+    Serial.println();
+}
@@ -0,0 +1,61 @@
+#include <Arduino.h>
+#include <RtcDS3231.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+
+template<typename T_RTC> void ConfigureDs3231(T_RTC& rtc)
+{
+    rtc.SetIsRunning(true);
+    rtc.Enable32kHzPin(false);
+    rtc.SetSquareWavePin(DS3231SquareWavePin_ModeClock);
+    rtc.SetSquareWavePinClockFrequency(DS3231SquareWaveClock_1Hz);
+    rtc.LatchAlarmsTriggeredFlags();
+    rtc.SetAgingOffset(-3);
+}
+
+void RegisterCacheBenchmarks()
+{
+    Serial.println("DS3231 register cache:");
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        ConfigureDs3231(rtc);
+        PrintlnBusCost("configuration uncached", wire);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        rtc.EnableRegisterCache(true);
+        rtc.RefreshRegisterCache();
+        PrintlnBusCost("RefreshRegisterCache", wire);
+
+        ConfigureDs3231(rtc);
+        PrintlnBusCost("configuration cached", wire);
+
+        PrintlnCheck("cached registers written", device.Registers[DS3231_REG_CONTROL] == 0x40 &&
+            device.Registers[DS3231_REG_STATUS] == 0x80 &&
+            (int8_t)device.Registers[DS3231_REG_AGING] == -3 &&
+            rtc.GetIsRunning() && rtc.GetAgingOffset() == -3);
+
+        // an alarm raised by the hardware is not lost by a cached update
+        device.TriggerAlarms(DS3231AlarmFlag_Alarm1);
+        rtc.Enable32kHzPin(true);
+        PrintlnCheck("hardware flags kept", rtc.LatchAlarmsTriggeredFlags() == DS3231AlarmFlag_Alarm1 &&
+            !rtc.IsDateTimeValid());
+
+        rtc.SetDateTime(RtcDateTime(2024, 2, 29, 12, 34, 56));
+        PrintlnCheck("OSF cleared", rtc.IsDateTimeValid() && (device.Registers[DS3231_REG_STATUS] & _BV(DS3231_EN32KHZ)));
+    }
+
+    Serial.println();
+}
@@ -0,0 +1,50 @@
+#include <Arduino.h>
+
+#include "RtcBenchmarkHelpers.h"
+
+volatile uint32_t benchmarkSink;
+uint16_t benchmarkFailures;
+
+void PrintPassFail(bool passed)
+{
+    if (passed)
+    {
+      Serial.print("passed");
+    }
+    else
+    {
+      Serial.print("failed");
+      benchmarkFailures++;
+    }
+}
+
+void PrintlnCheck(const char* name, bool passed)
+{
+    Serial.print(name);
+    Serial.print(" ");
+    PrintPassFail(passed);
+    Serial.println();
+}
+
+void PrintlnPerIteration(const char* name, uint32_t elapsedMicros, uint32_t iterations)
+{
+    Serial.print(name);
+    Serial.print(" ");
+    Serial.print((float)elapsedMicros / iterations, 3);
+    Serial.println("us");
+}
+
+void ControlLoopStep()
+{
+    for (uint8_t step = 0; step < 50; step++)
+        benchmarkSink += step;
+}
+
+void BenchmarkSimulateTime(bool enable)
+{
+#if defined(RTC_HOST)
+    hostSimulateTime(enable);
+#else
+    (void)enable;
+#endif
+}
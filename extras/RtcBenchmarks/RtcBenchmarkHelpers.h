@@ -0,0 +1,67 @@
+#ifndef __RTCBENCHMARKHELPERS_H__
+#define __RTCBENCHMARKHELPERS_H__
+
+#include <Arduino.h>
+
+// What the benchmark sections share, each section lives in a file of its
+// own and only depends on this and the simulators it uses, so it can be
+// built and run on its own as well as from RtcBenchmarks.ino
+
+// not connected to anything, but the DS3234 driver toggles it
+#define BenchmarkCsPin 10
+// ThreeWire benchmarks only read, so a DS1302 may be attached to these
+#define BenchmarkIoPin 4
+#define BenchmarkClkPin 5
+#define BenchmarkCePin 2
+
+const uint16_t c_ConversionIterations = 1000;
+
+// results are stored here so the compiler can't optimize the work away
+extern volatile uint32_t benchmarkSink;
+// the checks that failed so far
+extern uint16_t benchmarkFailures;
+
+void PrintPassFail(bool passed);
+void PrintlnCheck(const char* name, bool passed);
+void PrintlnPerIteration(const char* name, uint32_t elapsedMicros, uint32_t iterations);
+
+// stands in for the work of one pass of the caller's control loop
+void ControlLoopStep();
+
+// Checks on timing run against simulated time on the host, where the process
+// may be descheduled at any point.  On a board the time is always real.
+void BenchmarkSimulateTime(bool enable);
+
+template<typename T_BUS> void PrintlnBusCost(const char* name, T_BUS& bus)
+{
+    Serial.print(name);
+    Serial.print(" transactions ");
+    Serial.print(bus.Statistics.transactions);
+    Serial.print(" bytes ");
+    Serial.print(bus.Statistics.bytesWritten + bus.Statistics.bytesRead);
+    Serial.print(" bus ");
+    Serial.print(bus.Statistics.busMicros);
+    Serial.println("us");
+
+    bus.Statistics.Reset();
+}
+
+// the sections, in the order RtcBenchmarks.ino runs them
+void DateTimeBenchmarks();
+void TemperatureBenchmarks();
+void BusCostBenchmarks();
+void RegisterCacheBenchmarks();
+void SnapshotBenchmarks();
+void SplitReadBenchmarks();
+void ThreeWireBenchmarks();
+void MemoryBenchmarks();
+void EventLogBenchmarks();
+void TimeSeriesBenchmarks();
+void MemoryStoreBenchmarks();
+void ClockBenchmarks();
+void SetAtBoundaryBenchmarks();
+void CalibrationBenchmarks();
+void AlarmSchedulerBenchmarks();
+void SimulatorChecks();
+
+#endif // __RTCBENCHMARKHELPERS_H__
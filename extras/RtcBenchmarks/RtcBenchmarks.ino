@@ -0,0 +1,37 @@
+// These benchmarks do not rely on RTC hardware at all
+//
+// Each section prints the average cost of an operation so that
+// regressions show up as numbers rather than as a feeling.  The sections
+// are in the .cpp files next to this sketch, one per feature, and each can
+// also be built and run on its own on the host, see CMakeLists.txt
+
+#include "RtcBenchmarkHelpers.h"
+
+void setup ()
+{
+    Serial.begin(115200);
+    while (!Serial);
+    Serial.println();
+
+    DateTimeBenchmarks();
+    TemperatureBenchmarks();
+    BusCostBenchmarks();
+    RegisterCacheBenchmarks();
+    SnapshotBenchmarks();
+    SplitReadBenchmarks();
+    ThreeWireBenchmarks();
+    MemoryBenchmarks();
+    EventLogBenchmarks();
+    TimeSeriesBenchmarks();
+    MemoryStoreBenchmarks();
+    ClockBenchmarks();
+    SetAtBoundaryBenchmarks();
+    CalibrationBenchmarks();
+    AlarmSchedulerBenchmarks();
+    SimulatorChecks();
+}
+
+void loop ()
+{
+    delay(500);
+}
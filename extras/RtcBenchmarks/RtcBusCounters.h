@@ -0,0 +1,338 @@
+#ifndef __RTCBUSCOUNTERS_H__
+#define __RTCBUSCOUNTERS_H__
+
+#include <SPI.h>
+
+// Stand ins for the Wire, SPI and ThreeWire bus objects the Rtc drivers are
+// templated on.  They count the traffic each driver call generates and model
+// how long that traffic would keep the bus busy, no device is required.
+//
+// The device side is provided by overriding onWrite/onRead (or onTransfer), by
+// default every write is acknowledged and every read returns zeros.
+
+struct BusStatistics
+{
+    uint32_t transactions;
+    uint32_t bytesWritten;
+    uint32_t bytesRead;
+    uint32_t busMicros; // modelled time the bus was busy
+
+    void Reset()
+    {
+        transactions = 0;
+        bytesWritten = 0;
+        bytesRead = 0;
+        busMicros = 0;
+    }
+};
+
+// Arduino Wire libraries buffer 32 bytes in each direction
+const uint8_t c_CountingWireBufferSize = 32;
+
+class CountingTwoWire
+{
+public:
+    BusStatistics Statistics;
+
+    CountingTwoWire(uint32_t clockHz = 100000) :
+        _clockHz(clockHz),
+        _txAddress(0),
+        _txCount(0),
+        _rxCount(0),
+        _rxIndex(0),
+        _isRealTime(false),
+        _rxStartMicros(0)
+    {
+        Statistics.Reset();
+    }
+
+    // When enabled the modelled bus time passes in real time, as it would
+    // with an interrupt driven Wire library.  endTransmission() waits until
+    // the write has been clocked out while requestFrom() returns at once and
+    // the bytes become available() as they arrive, read() waits for a byte
+    // still in flight
+    void SetRealTimeLatency(bool enable)
+    {
+        _isRealTime = enable;
+    }
+
+    void begin()
+    {
+    }
+
+    void begin(int sda, int scl)
+    {
+    }
+
+    void beginTransmission(uint8_t address)
+    {
+        _txAddress = address;
+        _txCount = 0;
+    }
+
+    size_t write(uint8_t value)
+    {
+        if (_txCount >= c_CountingWireBufferSize)
+            return 0;
+
+        _txBuffer[_txCount++] = value;
+        return 1;
+    }
+
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        // start, address + ack, each byte + ack, stop
+        uint32_t start = micros();
+        uint32_t busMicros = countTransaction(_txCount, 0);
+
+        while (_isRealTime && (micros() - start) < busMicros)
+        {
+        }
+        return onWrite(_txAddress, _txBuffer, _txCount);
+    }
+
+    uint8_t requestFrom(uint8_t address, uint8_t count, bool sendStop = true)
+    {
+        if (count > c_CountingWireBufferSize)
+            count = c_CountingWireBufferSize;
+
+        _rxCount = onRead(address, _rxBuffer, count);
+        _rxIndex = 0;
+        _rxStartMicros = micros();
+
+        countTransaction(0, _rxCount);
+        return _rxCount;
+    }
+
+    int available()
+    {
+        return arrived() - _rxIndex;
+    }
+
+    int read()
+    {
+        if (_rxIndex >= _rxCount)
+            return -1;
+
+        while (_rxIndex >= arrived())
+        {
+        }
+        return _rxBuffer[_rxIndex++];
+    }
+
+protected:
+    // returns the Wire endTransmission error, 0 is success
+    virtual uint8_t onWrite(uint8_t address, const uint8_t* pData, uint8_t count)
+    {
+        return 0;
+    }
+
+    // returns the number of bytes the device supplied
+    virtual uint8_t onRead(uint8_t address, uint8_t* pData, uint8_t count)
+    {
+        memset(pData, 0, count);
+        return count;
+    }
+
+    // returns the modelled time the transaction kept the bus busy
+    uint32_t countTransaction(uint8_t written, uint8_t read)
+    {
+        Statistics.transactions++;
+        Statistics.bytesWritten += written;
+        Statistics.bytesRead += read;
+
+        // start and stop bits, plus nine clocks for the address and each byte
+        uint32_t bits = 2 + 9 * (1 + written + read);
+        uint32_t busMicros = bits * 1000000UL / _clockHz;
+        Statistics.busMicros += busMicros;
+        return busMicros;
+    }
+
+private:
+    const uint32_t _clockHz;
+
+    uint8_t _txAddress;
+    uint8_t _txCount;
+    uint8_t _txBuffer[c_CountingWireBufferSize];
+
+    uint8_t _rxCount;
+    uint8_t _rxIndex;
+    uint8_t _rxBuffer[c_CountingWireBufferSize];
+
+    bool _isRealTime;
+    uint32_t _rxStartMicros;
+
+    // the received bytes clocked in so far
+    uint8_t arrived()
+    {
+        if (!_isRealTime)
+            return _rxCount;
+
+        // the start bit and address, then nine clocks for each byte
+        uint32_t bits = (uint64_t)(micros() - _rxStartMicros) * _clockHz / 1000000UL;
+        uint32_t bytes = (bits < 10) ? 0 : (bits - 10) / 9;
+        return (bytes < _rxCount) ? bytes : _rxCount;
+    }
+};
+
+class CountingSpi
+{
+public:
+    BusStatistics Statistics;
+
+    CountingSpi(uint32_t clockHz = 1000000) :
+        _clockHz(clockHz),
+        _transactionBytes(0)
+    {
+        Statistics.Reset();
+    }
+
+    void begin()
+    {
+    }
+
+    void beginTransaction(SPISettings settings)
+    {
+        _transactionBytes = 0;
+        Statistics.transactions++;
+        onSelect();
+    }
+
+    void endTransaction()
+    {
+        Statistics.busMicros += _transactionBytes * 8 * 1000000UL / _clockHz;
+        onUnselect();
+    }
+
+    uint8_t transfer(uint8_t value)
+    {
+        // full duplex, each byte is only counted once as written
+        _transactionBytes++;
+        Statistics.bytesWritten++;
+        return onTransfer(value);
+    }
+
+    void transfer(void* pBuffer, size_t count)
+    {
+        uint8_t* pData = static_cast<uint8_t*>(pBuffer);
+
+        while (count--)
+        {
+            *pData = transfer(*pData);
+            ++pData;
+        }
+    }
+
+protected:
+    virtual void onSelect()
+    {
+    }
+
+    virtual void onUnselect()
+    {
+    }
+
+    // returns the byte shifted in while value is shifted out
+    virtual uint8_t onTransfer(uint8_t value)
+    {
+        return 0;
+    }
+
+private:
+    const uint32_t _clockHz;
+    uint32_t _transactionBytes;
+};
+
+class CountingThreeWire
+{
+public:
+    BusStatistics Statistics;
+
+    // ThreeWire clocks each bit with 1us high and low phases on top of
+    // the pin writes and needs 4us of CE setup and hold (tCC, tCWH)
+    CountingThreeWire(uint16_t bitNanos = 3000) :
+        _bitNanos(bitNanos),
+        _bitNanoAccumulator(0)
+    {
+        Statistics.Reset();
+    }
+
+    void begin()
+    {
+    }
+
+    void end()
+    {
+    }
+
+    void beginTransmission(uint8_t command)
+    {
+        Statistics.transactions++;
+        Statistics.busMicros += 4;
+        countBits(8);
+        onCommand(command);
+    }
+
+    void endTransmission()
+    {
+        Statistics.busMicros += 4;
+        onEnd();
+    }
+
+    void write(uint8_t value, bool isDataRequestCommand = false)
+    {
+        Statistics.bytesWritten++;
+        countBits(8);
+        onWrite(value);
+    }
+
+    uint8_t read()
+    {
+        Statistics.bytesRead++;
+        countBits(8);
+        return onRead();
+    }
+
+    void writeBytes(const uint8_t* pValues, uint8_t countBytes)
+    {
+        while (countBytes--)
+            write(*pValues++);
+    }
+
+    void readBytes(uint8_t* pValues, uint8_t countBytes)
+    {
+        while (countBytes--)
+            *pValues++ = read();
+    }
+
+protected:
+    virtual void onCommand(uint8_t command)
+    {
+    }
+
+    virtual void onEnd()
+    {
+    }
+
+    virtual void onWrite(uint8_t value)
+    {
+    }
+
+    virtual uint8_t onRead()
+    {
+        return 0;
+    }
+
+    void countBits(uint8_t bits)
+    {
+        _bitNanoAccumulator += (uint32_t)bits * _bitNanos;
+        Statistics.busMicros += _bitNanoAccumulator / 1000;
+        _bitNanoAccumulator %= 1000;
+    }
+
+private:
+    const uint16_t _bitNanos;
+    uint32_t _bitNanoAccumulator;
+};
+
+#endif // __RTCBUSCOUNTERS_H__
@@ -0,0 +1,116 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <ThreeWire.h>
+#include <RtcDS1302.h>
+#include <RtcDS1307.h>
+#include <RtcDS3231.h>
+#include <RtcDS3234.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedDs1307.h"
+#include "SimulatedDs1302.h"
+
+// records when the time registers were last written, the simulated write
+// happens at the end of the transaction
+class TimedDs3231 : public SimulatedDs3231
+{
+public:
+    TimedDs3231() :
+        SetMicros(0)
+    {
+    }
+
+    uint8_t OnWrite(const uint8_t* pData, uint8_t count)
+    {
+        if (count > 1 && pData[0] == 0x00)
+            SetMicros = micros();
+        return SimulatedDs3231::OnWrite(pData, count);
+    }
+
+    uint32_t SetMicros;
+};
+
+void SetAtBoundaryBenchmarks()
+{
+    Serial.println("SetDateTimeAtBoundary:");
+
+    const RtcDateTime now(2024, 2, 29, 12, 34, 56);
+    const uint32_t c_AllowedErrorMicros = 1000;
+
+    SimulatedTwoWire wire;
+    TimedDs3231 device;
+    wire.Attach(device);
+    wire.SetRealTimeLatency(true);
+    RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+    // the checks are on timing, so the host runs them on simulated time
+    BenchmarkSimulateTime(true);
+
+    // half way through the reference second, the write is aimed at the next
+    uint32_t referenceMicros = micros();
+    uint32_t latency = rtc.SetDateTimeAtBoundary(RtcTimestamp(now.TotalSeconds(), 16384), referenceMicros);
+    int32_t error = device.SetMicros - (referenceMicros + 500000);
+    bool isSet = rtc.GetDateTime() == RtcDateTime(now.TotalSeconds() + 1) && !rtc.LastError() &&
+        error >= 0 && error < static_cast<int32_t>(c_AllowedErrorMicros);
+
+    // the measured latency starts the next write early, by the part before
+    // the seconds byte as on real hardware
+    referenceMicros = micros();
+    latency = rtc.SetDateTimeAtBoundary(RtcTimestamp(now.TotalSeconds(), 16384), referenceMicros, latency);
+    int32_t compensated = device.SetMicros - (referenceMicros + 500000);
+    bool isCompensated = compensated < error && compensated > -static_cast<int32_t>(c_AllowedErrorMicros);
+
+    // too close to the boundary to make it, the one after is used
+    referenceMicros = micros();
+    rtc.SetDateTimeAtBoundary(RtcTimestamp(now.TotalSeconds(), 32767), referenceMicros, latency);
+    int32_t skipped = device.SetMicros - (referenceMicros + 1000000);
+    bool isSkipped = rtc.GetDateTime() == RtcDateTime(now.TotalSeconds() + 2) &&
+        skipped > -static_cast<int32_t>(c_AllowedErrorMicros) && skipped < static_cast<int32_t>(c_AllowedErrorMicros);
+
+    PrintlnCheck("DS3231 next second", isSet);
+    Serial.print("    write latency ");
+    Serial.print(latency);
+    Serial.print("us, error uncompensated ");
+    Serial.print(error);
+    Serial.println("us");
+    PrintlnCheck("DS3231 latency compensated", isCompensated);
+    Serial.print("    error compensated ");
+    Serial.print(compensated);
+    Serial.println("us");
+    PrintlnCheck("DS3231 close boundary skipped", isSkipped);
+
+    PrintlnCheck("DS3231 clears OSF", rtc.IsDateTimeValid());
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs1307 device;
+        wire.Attach(device);
+        RtcDS1307<SimulatedTwoWire> rtc(wire);
+        rtc.SetIsRunning(true);
+
+        rtc.SetDateTimeAtBoundary(RtcTimestamp(now.TotalSeconds(), 30000), micros());
+        PrintlnCheck("DS1307 next second", rtc.GetDateTime() == RtcDateTime(now.TotalSeconds() + 1) && rtc.GetIsRunning());
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+
+        rtc.SetDateTimeAtBoundary(RtcTimestamp(now.TotalSeconds(), 30000), micros());
+        PrintlnCheck("DS3234 next second", rtc.GetDateTime() == RtcDateTime(now.TotalSeconds() + 1) && rtc.IsDateTimeValid());
+    }
+
+    {
+        SimulatedDs1302 wire;
+        RtcDS1302<SimulatedDs1302> rtc(wire);
+        rtc.SetIsWriteProtected(false);
+
+        rtc.SetDateTimeAtBoundary(RtcTimestamp(now.TotalSeconds(), 30000), micros());
+        PrintlnCheck("DS1302 next second", rtc.GetDateTime() == RtcDateTime(now.TotalSeconds() + 1));
+    }
+
+    BenchmarkSimulateTime(false);
+    Serial.println();
+}
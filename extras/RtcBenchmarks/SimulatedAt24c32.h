@@ -0,0 +1,92 @@
+#ifndef __SIMULATEDAT24C32_H__
+#define __SIMULATEDAT24C32_H__
+
+#include "SimulatedTwoWire.h"
+
+const uint16_t c_SimulatedAt24c32Size = 4096;
+const uint8_t c_SimulatedAt24c32PageSize = 32;
+const uint32_t c_SimulatedAt24c32WriteCycleMicros = 5000;
+
+class SimulatedAt24c32 : public SimulatedI2cDevice
+{
+public:
+    SimulatedAt24c32(uint8_t addressBits = 0b111) :
+        SimulatedI2cDevice(0x50 | (addressBits & 0b111)),
+        PageWrites(0),
+        IsDataNacked(false),
+        _pointer(0),
+        _writeCycleStart(0),
+        _isWriting(false)
+    {
+        memset(Memory, 0xff, sizeof(Memory));
+    }
+
+    uint8_t Memory[c_SimulatedAt24c32Size];
+    uint32_t PageWrites;
+    // the address is taken but the data is not acknowledged
+    bool IsDataNacked;
+
+    bool IsWriting()
+    {
+        if (_isWriting && (micros() - _writeCycleStart) >= c_SimulatedAt24c32WriteCycleMicros)
+            _isWriting = false;
+        return _isWriting;
+    }
+
+    uint8_t OnWrite(const uint8_t* pData, uint8_t count)
+    {
+        // the device does not acknowledge anything during a write cycle
+        if (IsWriting())
+            return 2;
+
+        if (count < 2) // acknowledge polling only
+            return 0;
+
+        _pointer = ((pData[0] << 8) | pData[1]) % c_SimulatedAt24c32Size;
+        pData += 2;
+        count -= 2;
+
+        if (count && IsDataNacked)
+            return 3;
+
+        if (count)
+        {
+            // data wraps within the page of the starting address
+            uint16_t page = _pointer & ~(c_SimulatedAt24c32PageSize - 1);
+            uint8_t offset = _pointer & (c_SimulatedAt24c32PageSize - 1);
+
+            while (count--)
+            {
+                Memory[page + offset] = *pData++;
+                offset = (offset + 1) % c_SimulatedAt24c32PageSize;
+            }
+            _pointer = page + offset;
+
+            PageWrites++;
+            _isWriting = true;
+            _writeCycleStart = micros();
+        }
+        return 0;
+    }
+
+    uint8_t OnRead(uint8_t* pData, uint8_t count)
+    {
+        if (IsWriting())
+            return 0;
+
+        // reads continue from the last address used and wrap at the end of memory
+        for (uint8_t index = 0; index < count; ++index)
+        {
+            pData[index] = Memory[_pointer];
+            _pointer = (_pointer + 1) % c_SimulatedAt24c32Size;
+        }
+        return count;
+    }
+
+private:
+    uint16_t _pointer;
+    uint32_t _writeCycleStart;
+    bool _isWriting;
+};
+
+#endif // __SIMULATEDAT24C32_H__
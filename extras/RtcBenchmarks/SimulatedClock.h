@@ -0,0 +1,74 @@
+#ifndef __SIMULATEDCLOCK_H__
+#define __SIMULATEDCLOCK_H__
+
+#include <RtcDateTime.h>
+#include <RtcUtility.h>
+
+// Register level simulations of the devices this library supports, attached
+// to the counting busses so that every driver template runs against them
+// unchanged and the cost of each call can be measured without hardware.
+//
+// Time does not pass on its own, call AdvanceSeconds() to move the clocks.
+// Device behaviour that depends on elapsed time (the DS3231/DS3234
+// temperature conversion and the AT24C32 write cycle) follows micros().
+
+// shared handling of the seven BCD time registers all of the clocks use,
+// only their order and the flag bits they carry differ
+struct SimulatedClockLayout
+{
+    uint8_t second;
+    uint8_t minute;
+    uint8_t hour;
+    uint8_t dayOfWeek;
+    uint8_t dayOfMonth;
+    uint8_t month;
+    uint8_t year;
+    uint8_t secondFlags; // bits of the second register that are not time
+    uint8_t monthFlags;  // bits of the month register that are not time
+};
+
+const SimulatedClockLayout c_SimulatedDs323xLayout = { 0, 1, 2, 3, 4, 5, 6, 0x00, 0x80 };
+const SimulatedClockLayout c_SimulatedDs1307Layout = { 0, 1, 2, 3, 4, 5, 6, 0x80, 0x00 };
+const SimulatedClockLayout c_SimulatedDs1302Layout = { 0, 1, 2, 5, 3, 4, 6, 0x80, 0x00 };
+
+inline RtcDateTime SimulatedClockGet(const uint8_t* pRegisters, const SimulatedClockLayout& layout)
+{
+    uint16_t year = 2000 + BcdToUint8(pRegisters[layout.year]);
+    if (pRegisters[layout.month] & layout.monthFlags) // century
+        year += 100;
+
+    return RtcDateTime(year,
+        BcdToUint8(pRegisters[layout.month] & ~layout.monthFlags),
+        BcdToUint8(pRegisters[layout.dayOfMonth]),
+        BcdToBin24Hour(pRegisters[layout.hour]),
+        BcdToUint8(pRegisters[layout.minute]),
+        BcdToUint8(pRegisters[layout.second] & ~layout.secondFlags));
+}
+
+inline void SimulatedClockSet(uint8_t* pRegisters, const SimulatedClockLayout& layout, const RtcDateTime& dt)
+{
+    uint8_t year = dt.Year() - 2000;
+    uint8_t century = 0;
+    if (year >= 100)
+    {
+        year -= 100;
+        century = layout.monthFlags;
+    }
+
+    pRegisters[layout.second] = (pRegisters[layout.second] & layout.secondFlags) | Uint8ToBcd(dt.Second());
+    pRegisters[layout.minute] = Uint8ToBcd(dt.Minute());
+    pRegisters[layout.hour] = Uint8ToBcd(dt.Hour());
+    pRegisters[layout.dayOfWeek] = Uint8ToBcd(RtcDateTime::ConvertDowToRtc(dt.DayOfWeek()));
+    pRegisters[layout.dayOfMonth] = Uint8ToBcd(dt.Day());
+    pRegisters[layout.month] = Uint8ToBcd(dt.Month()) | century;
+    pRegisters[layout.year] = Uint8ToBcd(year);
+}
+
+inline void SimulatedClockAdvance(uint8_t* pRegisters, const SimulatedClockLayout& layout, uint32_t seconds)
+{
+    RtcDateTime now = SimulatedClockGet(pRegisters, layout);
+    now += seconds;
+    SimulatedClockSet(pRegisters, layout, now);
+}
+
+#endif // __SIMULATEDCLOCK_H__
@@ -0,0 +1,130 @@
+#ifndef __SIMULATEDDS1302_H__
+#define __SIMULATEDDS1302_H__
+
+#include <ThreeWire.h>
+
+#include "SimulatedClock.h"
+#include "RtcBusCounters.h"
+
+//
+// ThreeWire
+//
+
+const uint8_t c_SimulatedDs1302ClockCount = 9; // 0-6 time, 7 WP, 8 TCR
+const uint8_t c_SimulatedDs1302BurstAddress = 31;
+
+class SimulatedDs1302 : public CountingThreeWire
+{
+public:
+    SimulatedDs1302(uint16_t bitNanos = 3000) :
+        CountingThreeWire(bitNanos),
+        _isRam(false),
+        _isRead(false),
+        _isBurst(false),
+        _isActive(false),
+        _index(0),
+        _stagedCount(0)
+    {
+        memset(Clock, 0, sizeof(Clock));
+        memset(Ram, 0, sizeof(Ram));
+        Clock[0] = 0x80; // CH, the clock is halted at power on
+        Clock[3] = 0x01;
+        Clock[4] = 0x01;
+        Clock[5] = 0x01;
+        Clock[7] = 0x80; // WP
+        Clock[8] = 0x5c; // TCR disabled
+    }
+
+    uint8_t Clock[c_SimulatedDs1302ClockCount];
+    uint8_t Ram[31];
+
+    void AdvanceSeconds(uint32_t seconds)
+    {
+        if (!(Clock[0] & 0x80))
+            SimulatedClockAdvance(Clock, c_SimulatedDs1302Layout, seconds);
+    }
+
+protected:
+    void onCommand(uint8_t command)
+    {
+        // bit 7 must be set, bit 6 selects RAM, bits 5-1 address, bit 0 read
+        _isActive = (command & 0x80);
+        _isRam = (command & 0x40);
+        _isRead = (command & 0x01);
+        _index = (command >> 1) & 0x1f;
+        _isBurst = (_index == c_SimulatedDs1302BurstAddress);
+        if (_isBurst)
+            _index = 0;
+        _stagedCount = 0;
+    }
+
+    void onEnd()
+    {
+        // a clock burst write only takes effect once all eight registers
+        // including WP have been written
+        if (_isActive && !_isRam && _isBurst && !_isRead && _stagedCount >= 8)
+        {
+            if (!(Clock[7] & 0x80))
+                memcpy(Clock, _staged, 8);
+        }
+        _isActive = false;
+    }
+
+    void onWrite(uint8_t value)
+    {
+        if (!_isActive || _isRead)
+            return;
+
+        if (!_isRam && _isBurst)
+        {
+            if (_stagedCount < 8)
+                _staged[_stagedCount++] = value;
+            return;
+        }
+
+        // write protect blocks everything but the WP register itself
+        bool isProtected = (Clock[7] & 0x80) && (_isRam || _index != 7);
+
+        if (_isRam)
+        {
+            if (_index < sizeof(Ram) && !isProtected)
+                Ram[_index] = value;
+        }
+        else if (_index < c_SimulatedDs1302ClockCount && !isProtected)
+        {
+            Clock[_index] = value;
+        }
+
+        if (_isBurst)
+            _index++;
+    }
+
+    uint8_t onRead()
+    {
+        if (!_isActive || !_isRead)
+            return 0;
+
+        uint8_t value = 0;
+
+        if (_isRam)
+            value = (_index < sizeof(Ram)) ? Ram[_index] : 0;
+        else
+            value = (_index < c_SimulatedDs1302ClockCount) ? Clock[_index] : 0;
+
+        if (_isBurst)
+            _index++;
+
+        return value;
+    }
+
+private:
+    bool _isRam;
+    bool _isRead;
+    bool _isBurst;
+    bool _isActive;
+    uint8_t _index;
+    uint8_t _staged[8];
+    uint8_t _stagedCount;
+};
+
+#endif // __SIMULATEDDS1302_H__
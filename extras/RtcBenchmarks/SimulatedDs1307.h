@@ -0,0 +1,66 @@
+#ifndef __SIMULATEDDS1307_H__
+#define __SIMULATEDDS1307_H__
+
+#include "SimulatedClock.h"
+#include "SimulatedTwoWire.h"
+
+// 0x00 - 0x07 clock and control, 0x08 - 0x3f battery backed RAM
+const uint8_t c_SimulatedDs1307RegisterCount = 0x40;
+
+class SimulatedDs1307 : public SimulatedI2cDevice
+{
+public:
+    SimulatedDs1307() :
+        SimulatedI2cDevice(0x68),
+        _pointer(0)
+    {
+        memset(Registers, 0, sizeof(Registers));
+        Registers[0x00] = 0x80; // CH, the clock is halted at power on
+        Registers[0x03] = 0x01;
+        Registers[0x04] = 0x01;
+        Registers[0x05] = 0x01;
+        Registers[0x07] = 0x03; // control
+    }
+
+    uint8_t Registers[c_SimulatedDs1307RegisterCount];
+
+    void AdvanceSeconds(uint32_t seconds)
+    {
+        if (!(Registers[0x00] & 0x80))
+            SimulatedClockAdvance(Registers, c_SimulatedDs1307Layout, seconds);
+    }
+
+    uint8_t OnWrite(const uint8_t* pData, uint8_t count)
+    {
+        if (count)
+        {
+            _pointer = *pData++;
+            while (--count)
+            {
+                Registers[_pointer] = *pData++;
+                increment();
+            }
+        }
+        return 0;
+    }
+
+    uint8_t OnRead(uint8_t* pData, uint8_t count)
+    {
+        for (uint8_t index = 0; index < count; ++index)
+        {
+            pData[index] = Registers[_pointer];
+            increment();
+        }
+        return count;
+    }
+
+private:
+    uint8_t _pointer;
+
+    void increment()
+    {
+        _pointer = (_pointer + 1) % c_SimulatedDs1307RegisterCount;
+    }
+};
+
+#endif // __SIMULATEDDS1307_H__
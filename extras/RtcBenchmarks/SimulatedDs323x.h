@@ -0,0 +1,269 @@
+#ifndef __SIMULATEDDS323X_H__
+#define __SIMULATEDDS323X_H__
+
+#include <RtcTemperature.h>
+
+#include "SimulatedClock.h"
+#include "SimulatedTwoWire.h"
+
+// the register file shared by the DS3231 and DS3234, 0x00 - 0x12
+const uint8_t c_SimulatedDs323xRegisterCount = 0x13;
+const uint32_t c_SimulatedDs323xConversionMicros = 125000;
+
+class SimulatedDs323xRegisters
+{
+public:
+    SimulatedDs323xRegisters() :
+        AlarmsAfterStatusRead(0),
+        _conversionStart(0),
+        _isConverting(false)
+    {
+        memset(Registers, 0, sizeof(Registers));
+        Registers[0x05] = 0x01; // month
+        Registers[0x04] = 0x01; // day
+        Registers[0x03] = 0x01; // day of week
+        Registers[0x0e] = 0x1c; // control: RS2 RS1 INTCN
+        Registers[0x0f] = 0x88; // status: OSF EN32kHz
+        Registers[0x11] = 25;   // 25.00C
+    }
+
+    uint8_t Registers[c_SimulatedDs323xRegisterCount];
+    // alarm flags the hardware raises just after the next read of the
+    // status, between the read and the write of a read-modify-write
+    uint8_t AlarmsAfterStatusRead;
+
+    void AdvanceSeconds(uint32_t seconds)
+    {
+        SimulatedClockAdvance(Registers, c_SimulatedDs323xLayout, seconds);
+    }
+
+    void SetTemperature(int8_t degreesC, uint8_t quarters)
+    {
+        Registers[0x11] = degreesC;
+        Registers[0x12] = quarters << 6;
+    }
+
+    // hardware sets the alarm flags on a match
+    void TriggerAlarms(uint8_t flags)
+    {
+        Registers[0x0f] |= (flags & 0x03);
+    }
+
+    void StopOscillator()
+    {
+        Registers[0x0f] |= 0x80;
+    }
+
+    // the conversion the TCXO runs on its own every 64 seconds, it sets BSY
+    // but not CONV
+    void BeginAutomaticConversion()
+    {
+        update();
+        if (!_isConverting)
+        {
+            _isConverting = true;
+            _conversionStart = micros();
+            Registers[0x0f] |= 0x04; // BSY
+        }
+    }
+
+    bool IsConverting()
+    {
+        update();
+        return _isConverting;
+    }
+
+    uint8_t Read(uint8_t reg)
+    {
+        update();
+        if (reg >= c_SimulatedDs323xRegisterCount)
+            return 0;
+
+        uint8_t value = Registers[reg];
+        if (reg == 0x0f)
+        {
+            TriggerAlarms(AlarmsAfterStatusRead);
+            AlarmsAfterStatusRead = 0;
+        }
+        return value;
+    }
+
+    void Write(uint8_t reg, uint8_t value)
+    {
+        update();
+
+        switch (reg)
+        {
+        case 0x0e: // control
+            // CONV is only cleared by the hardware, and is ignored while busy
+            if ((value & 0x20) && !_isConverting && !(Registers[0x0f] & 0x04))
+            {
+                _isConverting = true;
+                _conversionStart = micros();
+                Registers[0x0f] |= 0x04; // BSY
+                Registers[reg] |= 0x20;
+            }
+            Registers[reg] = (value & ~0x20) | (Registers[reg] & 0x20);
+            break;
+
+        case 0x0f: // status
+            // OSF, A2F and A1F can only be cleared, BSY is read only
+            Registers[reg] = (value & 0x78) |
+                (Registers[reg] & value & 0x83) |
+                (Registers[reg] & 0x04);
+            break;
+
+        case 0x11: // temperature is read only
+        case 0x12:
+            break;
+
+        default:
+            if (reg < c_SimulatedDs323xRegisterCount)
+                Registers[reg] = value;
+            break;
+        }
+    }
+
+private:
+    uint32_t _conversionStart;
+    bool _isConverting;
+
+    void update()
+    {
+        if (_isConverting && (micros() - _conversionStart) >= c_SimulatedDs323xConversionMicros)
+        {
+            _isConverting = false;
+            Registers[0x0e] &= ~0x20; // CONV
+            Registers[0x0f] &= ~0x04; // BSY
+        }
+    }
+};
+
+class SimulatedDs3231 : public SimulatedI2cDevice, public SimulatedDs323xRegisters
+{
+public:
+    SimulatedDs3231() :
+        SimulatedI2cDevice(0x68),
+        _pointer(0)
+    {
+    }
+
+    uint8_t OnWrite(const uint8_t* pData, uint8_t count)
+    {
+        if (count)
+        {
+            _pointer = *pData++;
+            while (--count)
+            {
+                Write(_pointer, *pData++);
+                increment();
+            }
+        }
+        return 0;
+    }
+
+    uint8_t OnRead(uint8_t* pData, uint8_t count)
+    {
+        for (uint8_t index = 0; index < count; ++index)
+        {
+            pData[index] = Read(_pointer);
+            increment();
+        }
+        return count;
+    }
+
+private:
+    uint8_t _pointer;
+
+    void increment()
+    {
+        // the register pointer wraps after the last register
+        _pointer = (_pointer + 1) % c_SimulatedDs323xRegisterCount;
+    }
+};
+
+//
+// SPI
+//
+
+const uint8_t c_SimulatedDs3234RamAddress = 0x18;
+const uint8_t c_SimulatedDs3234RamData = 0x19;
+
+class SimulatedDs3234 : public CountingSpi, public SimulatedDs323xRegisters
+{
+public:
+    SimulatedDs3234(uint32_t clockHz = 1000000) :
+        CountingSpi(clockHz),
+        RamAddress(0),
+        _pointer(0),
+        _isWrite(false),
+        _isAddressed(false)
+    {
+        memset(Ram, 0, sizeof(Ram));
+    }
+
+    uint8_t Ram[256];
+    uint8_t RamAddress;
+
+protected:
+    void onSelect()
+    {
+        _isAddressed = false;
+    }
+
+    uint8_t onTransfer(uint8_t value)
+    {
+        // the first byte of each chip select is the address and direction
+        if (!_isAddressed)
+        {
+            _isAddressed = true;
+            _isWrite = (value & 0x80);
+            _pointer = value & 0x7f;
+            return 0;
+        }
+
+        uint8_t result = 0;
+
+        if (_pointer == c_SimulatedDs3234RamData)
+        {
+            // repeated access to the data register walks the SRAM
+            if (_isWrite)
+                Ram[RamAddress] = value;
+            else
+                result = Ram[RamAddress];
+            RamAddress++;
+            return result;
+        }
+
+        if (_pointer == c_SimulatedDs3234RamAddress)
+        {
+            if (_isWrite)
+                RamAddress = value;
+            else
+                result = RamAddress;
+        }
+        else if (_isWrite)
+        {
+            Write(_pointer, value);
+        }
+        else
+        {
+            result = Read(_pointer);
+        }
+
+        // the pointer wraps after the last timekeeping register
+        if (_pointer == c_SimulatedDs323xRegisterCount - 1)
+            _pointer = 0;
+        else
+            _pointer++;
+
+        return result;
+    }
+
+private:
+    uint8_t _pointer;
+    bool _isWrite;
+    bool _isAddressed;
+};
+
+#endif // __SIMULATEDDS323X_H__
@@ -0,0 +1,83 @@
+#ifndef __SIMULATEDTWOWIRE_H__
+#define __SIMULATEDTWOWIRE_H__
+
+#include "RtcBusCounters.h"
+
+//
+// I2C
+//
+
+class SimulatedI2cDevice
+{
+public:
+    SimulatedI2cDevice(uint8_t address) :
+        Address(address)
+    {
+    }
+
+    const uint8_t Address;
+
+    // a write transaction addressed to this device, returns the Wire
+    // endTransmission error, 0 is success and 2 is a NACK of the address
+    virtual uint8_t OnWrite(const uint8_t* pData, uint8_t count) = 0;
+
+    // a read transaction, returns the number of bytes supplied
+    virtual uint8_t OnRead(uint8_t* pData, uint8_t count) = 0;
+};
+
+const uint8_t c_SimulatedTwoWireMaxDevices = 4;
+
+class SimulatedTwoWire : public CountingTwoWire
+{
+public:
+    SimulatedTwoWire(uint32_t clockHz = 100000) :
+        CountingTwoWire(clockHz),
+        FailTransactions(0),
+        _deviceCount(0)
+    {
+    }
+
+    // this many of the next transactions fail as if nothing answered
+    uint8_t FailTransactions;
+
+    void Attach(SimulatedI2cDevice& device)
+    {
+        if (_deviceCount < c_SimulatedTwoWireMaxDevices)
+            _devices[_deviceCount++] = &device;
+    }
+
+protected:
+    uint8_t onWrite(uint8_t address, const uint8_t* pData, uint8_t count)
+    {
+        SimulatedI2cDevice* pDevice = find(address);
+        return pDevice && !isFailed() ? pDevice->OnWrite(pData, count) : 2;
+    }
+
+    uint8_t onRead(uint8_t address, uint8_t* pData, uint8_t count)
+    {
+        SimulatedI2cDevice* pDevice = find(address);
+        return pDevice && !isFailed() ? pDevice->OnRead(pData, count) : 0;
+    }
+
+private:
+    SimulatedI2cDevice* _devices[c_SimulatedTwoWireMaxDevices];
+    uint8_t _deviceCount;
+
+    bool isFailed()
+    {
+        if (FailTransactions == 0)
+            return false;
+        FailTransactions--;
+        return true;
+    }
+
+    SimulatedI2cDevice* find(uint8_t address)
+    {
+        for (uint8_t index = 0; index < _deviceCount; ++index)
+            if (_devices[index]->Address == address)
+                return _devices[index];
+        return NULL;
+    }
+};
+
+#endif // __SIMULATEDTWOWIRE_H__
@@ -0,0 +1,167 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <ThreeWire.h>
+#include <RtcDS1302.h>
+#include <RtcDS1307.h>
+#include <RtcDS3231.h>
+#include <RtcDS3234.h>
+#include <EepromAT24C32.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedDs1307.h"
+#include "SimulatedAt24c32.h"
+#include "SimulatedDs1302.h"
+
+// a replacement for ThreeWire with only read() and write(), as they were
+// written before the bursts
+class ByteThreeWire
+{
+public:
+    ByteThreeWire(SimulatedDs1302& device) :
+        _device(device)
+    {
+    }
+
+    void begin()
+    {
+        _device.begin();
+    }
+
+    void beginTransmission(uint8_t command)
+    {
+        _device.beginTransmission(command);
+    }
+
+    void endTransmission()
+    {
+        _device.endTransmission();
+    }
+
+    void write(uint8_t value, bool isDataRequestCommand = false)
+    {
+        _device.write(value, isDataRequestCommand);
+    }
+
+    uint8_t read()
+    {
+        return _device.read();
+    }
+
+private:
+    SimulatedDs1302& _device;
+};
+
+void SimulatorChecks()
+{
+    Serial.println("Simulated devices:");
+
+    const RtcDateTime now(2099, 12, 31, 23, 59, 50);
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        PrintlnCheck("DS3231 invalid at power on", !rtc.IsDateTimeValid());
+        rtc.SetDateTime(now);
+        PrintlnCheck("DS3231 valid once set", rtc.IsDateTimeValid());
+
+        device.AdvanceSeconds(20);
+        RtcDateTime later = rtc.GetDateTime();
+        PrintlnCheck("DS3231 century rollover", later.Year() == 2100 && later.Month() == 1 && later.Second() == 10);
+
+        device.SetTemperature(-12, 3);
+        PrintlnCheck("DS3231 temperature", rtc.GetTemperature().AsCentiDegC() == -1125);
+
+        device.TriggerAlarms(DS3231AlarmFlag_Alarm2);
+        PrintlnCheck("DS3231 alarm latch", rtc.LatchAlarmsTriggeredFlags() == DS3231AlarmFlag_Alarm2 &&
+            rtc.LatchAlarmsTriggeredFlags() == 0);
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+
+        rtc.SetDateTime(now);
+        PrintlnCheck("DS3234 date time", rtc.GetDateTime() == now);
+
+        // an alarm raised while OSF is being cleared is kept
+        spi.StopOscillator();
+        spi.AlarmsAfterStatusRead = DS3234AlarmFlag_Alarm1;
+        rtc.SetDateTime(now);
+        PrintlnCheck("DS3234 set keeps alarm flags", rtc.IsDateTimeValid() &&
+            rtc.LatchAlarmsTriggeredFlags() == DS3234AlarmFlag_Alarm1);
+
+        const uint8_t data[] = { 1, 2, 3, 4, 5 };
+        uint8_t read[sizeof(data)];
+        rtc.SetMemory(0xfe, data, sizeof(data));
+        rtc.GetMemory(0xfe, read, sizeof(read));
+        PrintlnCheck("DS3234 SRAM wraps", memcmp(data, read, sizeof(data)) == 0 && spi.Ram[2] == 5);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs1307 device;
+        wire.Attach(device);
+        RtcDS1307<SimulatedTwoWire> rtc(wire);
+
+        rtc.SetDateTime(now);
+        rtc.SetIsRunning(true);
+        device.AdvanceSeconds(5);
+        PrintlnCheck("DS1307 date time", rtc.GetDateTime().TotalSeconds() == now.TotalSeconds() + 5);
+
+        rtc.SetMemory(3, 0xa5);
+        PrintlnCheck("DS1307 memory", rtc.GetMemory(3) == 0xa5 && device.Registers[DS1307_REG_RAMSTART + 3] == 0xa5);
+    }
+
+    {
+        SimulatedDs1302 wire;
+        RtcDS1302<SimulatedDs1302> rtc(wire);
+
+        rtc.SetDateTime(now);
+        PrintlnCheck("DS1302 write protected", rtc.GetDateTime() != now);
+
+        rtc.SetIsWriteProtected(false);
+        rtc.SetDateTime(now);
+        PrintlnCheck("DS1302 date time", rtc.GetDateTime() == now);
+
+        uint8_t data[DS1302RamSize];
+        uint8_t read[DS1302RamSize];
+        for (uint8_t index = 0; index < sizeof(data); ++index)
+            data[index] = index * 7;
+        rtc.SetMemory(data, sizeof(data));
+        rtc.GetMemory(read, sizeof(read));
+        PrintlnCheck("DS1302 RAM burst", memcmp(data, read, sizeof(data)) == 0 && rtc.GetMemory(30) == data[30]);
+
+        ByteThreeWire byteWire(wire);
+        RtcDS1302<ByteThreeWire> byteRtc(byteWire);
+        const RtcDateTime later(2024, 3, 1, 0, 0, 1);
+
+        byteRtc.SetDateTime(later);
+        memset(read, 0, sizeof(read));
+        byteRtc.GetMemory(read, sizeof(read));
+        PrintlnCheck("DS1302 byte wise bursts", rtc.GetDateTime() == later && byteRtc.GetDateTime() == later &&
+            memcmp(data, read, sizeof(data)) == 0);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+
+        const uint8_t data[] = { 10, 11, 12, 13 };
+        eeprom.SetMemory(30, data, sizeof(data));
+        PrintlnCheck("AT24C32 read waits for write cycle", eeprom.GetMemory(30) == 10 && eeprom.LastError() == 0);
+
+        // SetMemory splits on the page boundary rather than wrapping
+        PrintlnCheck("AT24C32 page split", device.Memory[30] == 10 && device.Memory[31] == 11 &&
+            device.Memory[32] == 12 && device.Memory[33] == 13 && device.Memory[0] == 0xff &&
+            device.PageWrites == 2);
+    }
+
+    Serial.println();
+}
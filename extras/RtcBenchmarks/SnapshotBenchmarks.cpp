@@ -0,0 +1,77 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <RtcDS3231.h>
+#include <RtcDS3234.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+
+template<typename T_RTC> void MonitorDs323x(T_RTC& rtc)
+{
+    rtc.GetDateTime();
+    rtc.GetTemperature();
+    rtc.IsDateTimeValid();
+    rtc.GetAlarmOne();
+    rtc.GetAlarmTwo();
+    rtc.GetAgingOffset();
+}
+
+void SnapshotBenchmarks()
+{
+    Serial.println("Snapshot versus individual calls:");
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        rtc.SetDateTime(RtcDateTime(2024, 2, 29, 12, 34, 56));
+        rtc.SetAlarmOne(DS3231AlarmOne(1, 2, 3, 4, DS3231AlarmOneControl_HoursMinutesSecondsDayOfWeekMatch));
+        rtc.SetAlarmTwo(DS3231AlarmTwo(15, 6, 7, DS3231AlarmTwoControl_HoursMinutesDayOfMonthMatch));
+        rtc.SetAgingOffset(-7);
+        device.SetTemperature(-12, 0x40);
+        device.TriggerAlarms(DS3231AlarmFlag_Alarm2);
+        wire.Statistics.Reset();
+
+        MonitorDs323x(rtc);
+        PrintlnBusCost("DS3231 individual calls", wire);
+        DS3231Snapshot snapshot = rtc.GetSnapshot();
+        PrintlnBusCost("DS3231 GetSnapshot", wire);
+
+        PrintlnCheck("DS3231 snapshot matches", snapshot.DateTime() == rtc.GetDateTime() &&
+            snapshot.AlarmOne() == rtc.GetAlarmOne() &&
+            snapshot.AlarmTwo() == rtc.GetAlarmTwo() &&
+            snapshot.Temperature() == rtc.GetTemperature() &&
+            snapshot.AgingOffset() == -7 &&
+            snapshot.IsDateTimeValid() && snapshot.GetIsRunning() &&
+            snapshot.AlarmsTriggeredFlags() == DS3231AlarmFlag_Alarm2);
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+
+        rtc.SetDateTime(RtcDateTime(2024, 2, 29, 12, 34, 56));
+        rtc.SetAlarmOne(DS3234AlarmOne(1, 2, 3, 4, DS3234AlarmOneControl_HoursMinutesSecondsDayOfWeekMatch));
+        rtc.SetAlarmTwo(DS3234AlarmTwo(15, 6, 7, DS3234AlarmTwoControl_HoursMinutesDayOfMonthMatch));
+        rtc.SetAgingOffset(-7);
+        spi.SetTemperature(-12, 0x40);
+        spi.Statistics.Reset();
+
+        MonitorDs323x(rtc);
+        PrintlnBusCost("DS3234 individual calls", spi);
+        DS3234Snapshot snapshot = rtc.GetSnapshot();
+        PrintlnBusCost("DS3234 GetSnapshot", spi);
+
+        PrintlnCheck("DS3234 snapshot matches", snapshot.DateTime() == rtc.GetDateTime() &&
+            snapshot.AlarmOne() == rtc.GetAlarmOne() &&
+            snapshot.AlarmTwo() == rtc.GetAlarmTwo() &&
+            snapshot.Temperature() == rtc.GetTemperature() &&
+            snapshot.AgingOffset() == -7 &&
+            snapshot.IsDateTimeValid() && snapshot.GetIsRunning());
+    }
+
+    Serial.println();
+}
@@ -0,0 +1,93 @@
+#include <Arduino.h>
+#include <RtcDS1307.h>
+#include <RtcDS3231.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedDs1307.h"
+
+const uint8_t c_SplitReads = 20;
+
+static void PrintlnControlLoopSteps(const char* name, uint32_t elapsedMicros, uint32_t steps)
+{
+    PrintlnPerIteration(name, elapsedMicros, c_SplitReads);
+    Serial.print("  control loop steps per read ");
+    Serial.println((float)steps / c_SplitReads, 1);
+}
+
+template<typename T_RTC, typename T_WIRE> void SplitReadBenchmark(const char* name, T_RTC& rtc, T_WIRE& wire)
+{
+    typename T_RTC::SplitDateTime splitNow(wire);
+    RtcDateTime expected = rtc.GetDateTime();
+    uint32_t steps = 0;
+
+    Serial.println(name);
+
+    // blocking, the control loop only runs between reads
+    uint32_t start = micros();
+    for (uint8_t read = 0; read < c_SplitReads; read++)
+    {
+        benchmarkSink = rtc.GetDateTime();
+        ControlLoopStep();
+        steps++;
+    }
+    PrintlnControlLoopSteps(" GetDateTime", micros() - start, steps);
+
+    // stepped, the control loop keeps running while the read is in flight
+    bool isCorrect = true;
+    steps = 0;
+    start = micros();
+    for (uint8_t read = 0; read < c_SplitReads; read++)
+    {
+        RtcAsyncState state = rtc.StartGetDateTime(splitNow) ? RtcAsyncState_Busy : RtcAsyncState_Error;
+        while (state == RtcAsyncState_Busy)
+        {
+            ControlLoopStep();
+            steps++;
+            state = rtc.ProcessGetDateTime(splitNow);
+        }
+        isCorrect = isCorrect && (state == RtcAsyncState_Complete) && (rtc.CompleteGetDateTime(splitNow) == expected);
+    }
+    PrintlnControlLoopSteps(" Start/Process/CompleteGetDateTime", micros() - start, steps);
+    PrintlnCheck(" split read result", isCorrect);
+}
+
+void SplitReadBenchmarks()
+{
+    Serial.println("Split phase reads with real time bus latency:");
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        rtc.SetDateTime(RtcDateTime(2024, 2, 29, 12, 34, 56));
+        wire.SetRealTimeLatency(true);
+        SplitReadBenchmark("DS3231", rtc, wire);
+    }
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs1307 device;
+        wire.Attach(device);
+        RtcDS1307<SimulatedTwoWire> rtc(wire);
+
+        rtc.SetDateTime(RtcDateTime(2024, 2, 29, 12, 34, 56));
+        wire.SetRealTimeLatency(true);
+        SplitReadBenchmark("DS1307", rtc, wire);
+    }
+
+    {
+        // a device that never answers times out rather than staying busy
+        SimulatedTwoWire wire;
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+        RtcDS3231<SimulatedTwoWire>::SplitDateTime splitNow(wire);
+
+        PrintlnCheck("missing device", !rtc.StartGetDateTime(splitNow) && rtc.ProcessGetDateTime(splitNow) == RtcAsyncState_Error &&
+            rtc.LastError() == 2);
+    }
+
+    Serial.println();
+}
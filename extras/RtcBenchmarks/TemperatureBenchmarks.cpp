@@ -0,0 +1,147 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <RtcDS3231.h>
+#include <RtcDS3234.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+
+// counts the characters printed to it and throws them away
+class NullStream : public Stream
+{
+public:
+    uint32_t Count = 0;
+
+    size_t write(uint8_t) { ++Count; return 1; }
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+};
+
+static void TemperatureFormatBenchmarks()
+{
+    Serial.println("Temperature formatting:");
+
+    NullStream sink;
+
+    uint32_t start = micros();
+    for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+    {
+        // walk the registers as the DS3231 reports them, quarter degrees
+        RtcTemperature temperature((int8_t)(iteration >> 2), (iteration & 0x03) << 6);
+        benchmarkSink = temperature.AsCentiDegC();
+    }
+    uint32_t elapsed = micros() - start;
+    PrintlnPerIteration("RtcTemperature(registers)", elapsed, c_ConversionIterations);
+
+    start = micros();
+    for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+    {
+        RtcTemperature temperature(iteration * 25 - 12500);
+        temperature.Print(sink);
+    }
+    elapsed = micros() - start;
+    PrintlnPerIteration("Print", elapsed, c_ConversionIterations);
+
+    start = micros();
+    for (uint16_t iteration = 0; iteration < c_ConversionIterations; ++iteration)
+    {
+        RtcTemperature temperature(iteration * 25 - 12500);
+        sink.print(temperature.AsFloatDegC(), 2);
+    }
+    elapsed = micros() - start;
+    PrintlnPerIteration("print(AsFloatDegC())", elapsed, c_ConversionIterations);
+
+    Serial.println();
+}
+
+template<typename T_RTC, typename T_BUS> void TemperatureConversionBenchmark(const char* name,
+    T_RTC& rtc,
+    T_BUS& bus,
+    SimulatedDs323xRegisters& device)
+{
+    Serial.println(name);
+    device.SetTemperature(31, 3);
+    bus.Statistics.Reset();
+
+    uint32_t start = micros();
+    rtc.ForceTemperatureCompensationUpdate(true);
+    PrintlnPerIteration(" ForceTemperatureCompensationUpdate(true)", micros() - start, 1);
+    PrintlnBusCost(" ", bus);
+
+    uint32_t steps = 0;
+    start = micros();
+    RtcAsyncState state = rtc.StartTemperatureConversion() ? RtcAsyncState_Busy : RtcAsyncState_Error;
+    while (state == RtcAsyncState_Busy)
+    {
+        ControlLoopStep();
+        steps++;
+        state = rtc.ProcessTemperatureConversion();
+    }
+    RtcTemperature temperature = rtc.CompleteTemperatureConversion();
+    PrintlnPerIteration(" Start/Process/CompleteTemperatureConversion", micros() - start, 1);
+    PrintlnBusCost(" ", bus);
+    Serial.print("  control loop steps ");
+    Serial.println(steps);
+    PrintlnCheck(" conversion complete", state == RtcAsyncState_Complete &&
+        !device.IsConverting() && temperature.AsCentiDegC() == 3175);
+
+    // a blocking update while a stepped conversion is in flight waits for
+    // it rather than abandoning it, its result is still collected
+    BenchmarkSimulateTime(true);
+    bool isStarted = rtc.StartTemperatureConversion();
+    rtc.ForceTemperatureCompensationUpdate(true);
+    state = rtc.ProcessTemperatureConversion();
+    temperature = rtc.CompleteTemperatureConversion();
+    BenchmarkSimulateTime(false);
+    PrintlnCheck(" update waits for conversion", isStarted && state == RtcAsyncState_Complete &&
+        !device.IsConverting() && temperature.AsCentiDegC() == 3175);
+
+    // a forced conversion waits for the automatic one to finish
+    device.BeginAutomaticConversion();
+    rtc.StartTemperatureConversion();
+    bool isDeferred = !(device.Registers[0x0e] & 0x20);
+    temperature = rtc.GetTemperature(true);
+    PrintlnCheck(" deferred while busy", isDeferred && !device.IsConverting() && temperature.AsCentiDegC() == 3175);
+
+    // a BSY that never clears times out, and says so
+    device.Registers[0x0f] |= 0x04;
+    state = rtc.StartTemperatureConversion() ? RtcAsyncState_Busy : RtcAsyncState_Error;
+    while (state == RtcAsyncState_Busy)
+    {
+        delay(1);
+        state = rtc.ProcessTemperatureConversion();
+    }
+    device.Registers[0x0f] &= ~0x04;
+    PrintlnCheck(" timeout reported", state == RtcAsyncState_Error && rtc.LastError() == c_RtcWireTimeoutError);
+}
+
+static void TemperatureConversionBenchmarks()
+{
+    Serial.println("Temperature conversions:");
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedDs3231 device;
+        wire.Attach(device);
+        RtcDS3231<SimulatedTwoWire> rtc(wire);
+
+        TemperatureConversionBenchmark("DS3231", rtc, wire, device);
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+
+        TemperatureConversionBenchmark("DS3234", rtc, spi, spi);
+    }
+
+    Serial.println();
+}
+
+void TemperatureBenchmarks()
+{
+    TemperatureFormatBenchmarks();
+    TemperatureConversionBenchmarks();
+}
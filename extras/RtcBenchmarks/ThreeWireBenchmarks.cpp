@@ -0,0 +1,86 @@
+#include <Arduino.h>
+#include <ThreeWire.h>
+#include <ThreeWireDirect.h>
+#include <RtcDS1302.h>
+
+#include "RtcBenchmarkHelpers.h"
+
+const uint8_t c_ThreeWireBursts = 20;
+
+static void PrintlnThreeWireBurst(const char* name, uint32_t elapsedMicros, uint8_t bytesPerBurst)
+{
+    PrintlnPerIteration(name, elapsedMicros, c_ThreeWireBursts);
+#if defined(F_CPU)
+    Serial.print("  cycles per byte ");
+    Serial.println((float)elapsedMicros * (F_CPU / 1000000UL) / ((uint32_t)c_ThreeWireBursts * bytesPerBurst), 0);
+#else
+    Serial.print("  us per byte ");
+    Serial.println((float)elapsedMicros / ((uint32_t)c_ThreeWireBursts * bytesPerBurst), 2);
+#endif
+}
+
+// burst reads, the command and the bytes within one CE
+template<typename T_WIRE> void ThreeWireBenchmark(const char* name, T_WIRE& wire)
+{
+    uint8_t memory[DS1302RamSize];
+
+    Serial.println(name);
+    wire.begin();
+
+    uint32_t start = micros();
+    for (uint8_t burst = 0; burst < c_ThreeWireBursts; burst++)
+    {
+        wire.beginTransmission(DS1302_REG_TIMEDATE_BURST | THREEWIRE_READFLAG);
+        for (uint8_t index = 0; index < DS1302_REG_TIMEDATE_BURST_SIZE; index++)
+            memory[index] = wire.read();
+        wire.endTransmission();
+    }
+    PrintlnThreeWireBurst(" clock burst read()", micros() - start, 1 + DS1302_REG_TIMEDATE_BURST_SIZE);
+
+    start = micros();
+    for (uint8_t burst = 0; burst < c_ThreeWireBursts; burst++)
+    {
+        wire.beginTransmission(DS1302_REG_TIMEDATE_BURST | THREEWIRE_READFLAG);
+        wire.readBytes(memory, DS1302_REG_TIMEDATE_BURST_SIZE);
+        wire.endTransmission();
+    }
+    PrintlnThreeWireBurst(" clock burst readBytes()", micros() - start, 1 + DS1302_REG_TIMEDATE_BURST_SIZE);
+
+    start = micros();
+    for (uint8_t burst = 0; burst < c_ThreeWireBursts; burst++)
+    {
+        wire.beginTransmission(DS1302_REG_RAM_BURST | THREEWIRE_READFLAG);
+        for (uint8_t index = 0; index < DS1302RamSize; index++)
+            memory[index] = wire.read();
+        wire.endTransmission();
+    }
+    PrintlnThreeWireBurst(" RAM burst read()", micros() - start, 1 + DS1302RamSize);
+
+    start = micros();
+    for (uint8_t burst = 0; burst < c_ThreeWireBursts; burst++)
+    {
+        wire.beginTransmission(DS1302_REG_RAM_BURST | THREEWIRE_READFLAG);
+        wire.readBytes(memory, DS1302RamSize);
+        wire.endTransmission();
+    }
+    PrintlnThreeWireBurst(" RAM burst readBytes()", micros() - start, 1 + DS1302RamSize);
+
+    wire.end();
+    benchmarkSink = memory[0];
+}
+
+void ThreeWireBenchmarks()
+{
+    Serial.println("ThreeWire burst reads:");
+
+    ThreeWire wire(BenchmarkIoPin, BenchmarkClkPin, BenchmarkCePin);
+    ThreeWireBenchmark("ThreeWire", wire);
+
+    ThreeWireDirect<BenchmarkIoPin, BenchmarkClkPin, BenchmarkCePin> direct;
+    ThreeWireBenchmark("ThreeWireDirect 2V timing", direct);
+
+    ThreeWireDirect<BenchmarkIoPin, BenchmarkClkPin, BenchmarkCePin, ThreeWireTiming5V> direct5V;
+    ThreeWireBenchmark("ThreeWireDirect 5V timing", direct5V);
+
+    Serial.println();
+}
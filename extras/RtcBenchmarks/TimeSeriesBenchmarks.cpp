@@ -0,0 +1,192 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <RtcDS3234.h>
+#include <EepromAT24C32.h>
+#include <RtcTimeSeries.h>
+
+#include "RtcBenchmarkHelpers.h"
+#include "SimulatedTwoWire.h"
+#include "SimulatedDs323x.h"
+#include "SimulatedAt24c32.h"
+
+// a sample a minute with a second of jitter, of a slowly changing temperature
+static void TimeSeriesSample(uint16_t index, RtcDateTime& time, int32_t& value)
+{
+    const uint32_t origin = RtcDateTime(2024, 6, 1, 0, 0, 0).TotalSeconds();
+    int8_t jitter = (index * 7) % 3 - 1;
+    uint8_t phase = index % 40;
+
+    time = RtcDateTime(origin + index * 60 + jitter);
+    value = 2500 + ((phase < 20) ? phase : 40 - phase) * 3;
+}
+
+static uint16_t s_seriesFound;
+static bool s_isSeriesMatched;
+static uint16_t s_seriesIndex;
+
+static void CheckSeriesSample(const RtcDateTime& time, int32_t value)
+{
+    RtcDateTime expectedTime;
+    int32_t expectedValue;
+
+    TimeSeriesSample(s_seriesIndex++, expectedTime, expectedValue);
+    s_isSeriesMatched &= (time == expectedTime && value == expectedValue);
+    s_seriesFound++;
+}
+
+static int32_t s_extremes[3];
+
+static void KeepExtreme(const RtcDateTime& time, int32_t value)
+{
+    if (s_seriesFound < 3) {
+        s_extremes[s_seriesFound] = value;
+    }
+    s_seriesFound++;
+}
+
+void TimeSeriesBenchmarks()
+{
+    Serial.println("Time series:");
+
+    const uint16_t c_Samples = 1000;
+    RtcDateTime time;
+    int32_t value;
+
+    {
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+        RtcTimeSeriesStore<EepromAt24c32<SimulatedTwoWire>, 32> store(eeprom, 0, AT24C32_SIZE);
+
+        store.Format();
+
+        uint32_t start = micros();
+        uint16_t appended = 0;
+        for (uint16_t index = 0; index < c_Samples; index++) {
+            TimeSeriesSample(index, time, value);
+            appended += store.Append(time, value);
+        }
+        store.Flush();
+        PrintlnPerIteration("Append", micros() - start, c_Samples);
+
+        // against a 4 byte TotalSeconds() and 2 byte value per sample
+        uint16_t used = store.BlockCount() * 32;
+        Serial.print(c_Samples);
+        Serial.print(" samples in ");
+        Serial.print(used);
+        Serial.print(" bytes, ");
+        Serial.print((float)used / c_Samples, 2);
+        Serial.print(" bytes per sample, ratio ");
+        Serial.println((float)c_Samples * 6 / used, 2);
+        eeprom.GetMemory(0); // the last write cycle
+        wire.Statistics.Reset();
+
+        RtcTimeSeriesStore<EepromAt24c32<SimulatedTwoWire>, 32> again(eeprom, 0, AT24C32_SIZE);
+        again.Begin();
+        PrintlnBusCost("Begin", wire);
+        PrintlnCheck("recovered blocks", appended == c_Samples && again.BlockCount() == store.BlockCount());
+
+        // half an hour from the middle decodes only the blocks it covers
+        RtcDateTime from;
+        RtcDateTime to;
+        TimeSeriesSample(500, from, value);
+        TimeSeriesSample(529, to, value);
+        s_seriesFound = 0;
+        s_isSeriesMatched = true;
+        s_seriesIndex = 500;
+        uint16_t found = again.ForEachInRange(from, to, CheckSeriesSample);
+        PrintlnBusCost("ForEachInRange 30 samples", wire);
+        PrintlnCheck("time window", found == 30 && s_seriesFound == 30 && s_isSeriesMatched);
+
+        // appending continues the last block
+        TimeSeriesSample(c_Samples, time, value);
+        again.Append(time, value);
+        again.Flush();
+        s_seriesFound = 0;
+        s_isSeriesMatched = true;
+        s_seriesIndex = 0;
+        found = again.ForEachInRange(RtcDateTime(0), time, CheckSeriesSample);
+        PrintlnCheck("append after recovery", found == c_Samples + 1 && s_isSeriesMatched &&
+            again.BlockCount() == store.BlockCount());
+    }
+
+    {
+        SimulatedDs3234 spi;
+        RtcDS3234<SimulatedDs3234> rtc(spi, BenchmarkCsPin);
+        RtcTimeSeriesStore<RtcDS3234<SimulatedDs3234>, 32> store(rtc, 0, 256);
+
+        store.Format();
+
+        uint16_t appended = 0;
+        for (uint16_t index = 0; index < c_Samples; index++) {
+            TimeSeriesSample(index, time, value);
+            if (!store.Append(time, value)) break;
+            appended++;
+        }
+
+        Serial.print("DS3234 SRAM holds ");
+        Serial.print(appended);
+        Serial.println(" samples");
+
+        s_seriesFound = 0;
+        s_isSeriesMatched = true;
+        s_seriesIndex = 0;
+        store.ForEachInRange(RtcDateTime(0), time, CheckSeriesSample);
+        PrintlnCheck("DS3234 SRAM store", s_seriesFound == appended && s_isSeriesMatched && 
+            store.BlockCount() == store.BlockCapacity());
+    }
+
+    {
+        // a change beyond an int32 starts the next block rather than wrapping
+        const int32_t c_Min = -2147483647 - 1;
+        const int32_t c_Max = 2147483647;
+
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+        RtcTimeSeriesStore<EepromAt24c32<SimulatedTwoWire>, 32> store(eeprom, 0, 128);
+
+        RtcTimeSeriesEncoder<32> encoder;
+        bool isRejected = encoder.Add(0, c_Min) && !encoder.Add(60, c_Max) && encoder.Count() == 1;
+
+        store.Format();
+        store.Append(RtcDateTime(0), c_Min);
+        store.Append(RtcDateTime(60), c_Max);
+        store.Append(RtcDateTime(120), c_Min);
+        store.Flush();
+
+        s_seriesFound = 0;
+        store.ForEachInRange(RtcDateTime(0), RtcDateTime(120), KeepExtreme);
+        PrintlnCheck("int32 extremes", isRejected && store.BlockCount() == 3 && s_seriesFound == 3 &&
+            s_extremes[0] == c_Min && s_extremes[1] == c_Max && s_extremes[2] == c_Min);
+    }
+
+    {
+        // a sample back in time is refused rather than starting a block
+        // with an earlier header, also once the store is recovered
+        SimulatedTwoWire wire;
+        SimulatedAt24c32 device;
+        wire.Attach(device);
+        EepromAt24c32<SimulatedTwoWire> eeprom(wire);
+        RtcTimeSeriesStore<EepromAt24c32<SimulatedTwoWire>, 32> store(eeprom, 0, 128);
+
+        store.Format();
+        bool isRefused = store.Append(RtcDateTime(600), 1) &&
+            !store.Append(RtcDateTime(540), 2) &&
+            store.BlockCount() == 1 &&
+            store.Append(RtcDateTime(600), 3);
+        store.Flush();
+
+        RtcTimeSeriesStore<EepromAt24c32<SimulatedTwoWire>, 32> again(eeprom, 0, 128);
+        again.Begin();
+        isRefused = isRefused && !again.Append(RtcDateTime(540), 4) && again.Append(RtcDateTime(660), 5);
+
+        s_seriesFound = 0;
+        again.ForEachInRange(RtcDateTime(0), RtcDateTime(660), KeepExtreme);
+        PrintlnCheck("out of order refused", isRefused && again.BlockCount() == 1 && s_seriesFound == 3);
+    }
+
+    Serial.println();
+}
@@ -12,6 +12,9 @@ void PrintPassFail(bool passed)
     else
     {
       Serial.print("failed");
+#if defined(RTC_HOST)
+      hostExitStatus = 1;
+#endif
     }
 }
 
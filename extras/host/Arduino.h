@@ -0,0 +1,193 @@
+#ifndef __HOST_ARDUINO_H__
+#define __HOST_ARDUINO_H__
+
+// The parts of the Arduino core the library and its test sketches use, so
+// they build and run on the host.  Time comes from the steady clock, the pins
+// read low and Serial writes to stdout.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PROGMEM
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define pgm_read_word(p) (*(const uint16_t*)(p))
+#define F(s) (s)
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define BIN 2
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+uint32_t micros();
+uint32_t millis();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// Host only.  While enabled micros() and millis() follow a simulated clock
+// that moves only with delay(), delayMicroseconds() and a microsecond for
+// each read, so a check on timing gives the same result under any load.
+void hostSimulateTime(bool enable);
+
+// Host only.  main() returns this, a test sets it when a check failed.
+extern int hostExitStatus;
+
+inline void pinMode(uint8_t, uint8_t)
+{
+}
+inline void digitalWrite(uint8_t, uint8_t)
+{
+}
+inline int digitalRead(uint8_t)
+{
+    return LOW;
+}
+
+inline void interrupts()
+{
+}
+inline void noInterrupts()
+{
+}
+inline int digitalPinToInterrupt(uint8_t pin)
+{
+    return pin;
+}
+inline void attachInterrupt(int, void (*)(), int)
+{
+}
+inline void detachInterrupt(int)
+{
+}
+
+class Print
+{
+public:
+    virtual ~Print()
+    {
+    }
+
+    virtual size_t write(uint8_t c)
+    {
+        return (putchar(c) == EOF) ? 0 : 1;
+    }
+
+    size_t print(const char* s)
+    {
+        return printf("%s", s);
+    }
+    size_t print(char c)
+    {
+        return printf("%c", c);
+    }
+    size_t print(unsigned char value, int base = DEC)
+    {
+        return print(static_cast<unsigned long>(value), base);
+    }
+    size_t print(int value, int base = DEC)
+    {
+        return print(static_cast<long>(value), base);
+    }
+    size_t print(unsigned int value, int base = DEC)
+    {
+        return print(static_cast<unsigned long>(value), base);
+    }
+    size_t print(long value, int base = DEC)
+    {
+        if (base == DEC) return printf("%ld", value);
+        return print(static_cast<unsigned long>(value), base);
+    }
+    size_t print(unsigned long value, int base = DEC)
+    {
+        if (base == HEX) return printf("%lX", value);
+        if (base == BIN) return printBinary(value);
+        return printf("%lu", value);
+    }
+    size_t print(double value, int digits = 2)
+    {
+        return printf("%.*f", digits, value);
+    }
+
+    size_t println()
+    {
+        return print("\n");
+    }
+    template<typename T> size_t println(T value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+    template<typename T> size_t println(T value, int format)
+    {
+        size_t n = print(value, format);
+        return n + println();
+    }
+
+private:
+    size_t printBinary(unsigned long value)
+    {
+        char digits[sizeof(value) * 8 + 1];
+        char* p = &digits[sizeof(digits) - 1];
+
+        *p = '\0';
+        do {
+            *--p = '0' + (value & 1);
+            value >>= 1;
+        } while (value);
+        return print(p);
+    }
+};
+
+class Stream : public Print
+{
+public:
+    virtual int available()
+    {
+        return 0;
+    }
+    virtual int read()
+    {
+        return -1;
+    }
+    virtual int peek()
+    {
+        return -1;
+    }
+};
+
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long)
+    {
+    }
+    operator bool() const
+    {
+        return true;
+    }
+};
+
+extern HardwareSerial Serial;
+
+// the sketch
+void setup();
+void loop();
+
+#endif // __HOST_ARDUINO_H__
@@ -0,0 +1,98 @@
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <chrono>
+#include <thread>
+
+// runs setup() of the sketch once, the test sketches do all of their work
+// there
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+int hostExitStatus = 0;
+
+static const std::chrono::steady_clock::time_point s_start = std::chrono::steady_clock::now();
+
+// the simulated clock carries on from the real one and back, so intervals
+// that span a switch stay short
+static bool s_isSimulated = false;
+static uint64_t s_simulatedMicros = 0;
+static uint64_t s_realOffsetMicros = 0;
+
+static uint64_t realMicros()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - s_start).count()) + s_realOffsetMicros;
+}
+
+static uint64_t nowMicros()
+{
+    // each read takes a microsecond, so a loop waiting on the clock ends
+    return s_isSimulated ? s_simulatedMicros++ : realMicros();
+}
+
+void hostSimulateTime(bool enable)
+{
+    if (enable == s_isSimulated) return;
+
+    if (enable)
+    {
+        s_simulatedMicros = realMicros();
+    }
+    else
+    {
+        uint64_t real = realMicros();
+
+        if (s_simulatedMicros > real) s_realOffsetMicros += s_simulatedMicros - real;
+    }
+    s_isSimulated = enable;
+}
+
+uint32_t micros()
+{
+    return static_cast<uint32_t>(nowMicros());
+}
+
+uint32_t millis()
+{
+    return static_cast<uint32_t>(nowMicros() / 1000);
+}
+
+void delay(uint32_t ms)
+{
+    if (s_isSimulated)
+    {
+        s_simulatedMicros += static_cast<uint64_t>(ms) * 1000;
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// spins as on a board, a sleep this short overshoots by the scheduler tick
+void delayMicroseconds(uint32_t us)
+{
+    if (s_isSimulated)
+    {
+        s_simulatedMicros += us;
+        return;
+    }
+
+    uint32_t start = micros();
+
+    while (micros() - start < us)
+    {
+    }
+}
+
+void yield()
+{
+    std::this_thread::yield();
+}
+
+int main()
+{
+    setup();
+    fflush(stdout);
+    return hostExitStatus;
+}
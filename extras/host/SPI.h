@@ -0,0 +1,49 @@
+#ifndef __HOST_SPI_H__
+#define __HOST_SPI_H__
+
+#include <Arduino.h>
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0c
+
+// no device answers, what is written is read back
+class SPISettings
+{
+public:
+    SPISettings(uint32_t = 4000000, uint8_t = MSBFIRST, uint8_t = SPI_MODE0)
+    {
+    }
+};
+
+class SPIClass
+{
+public:
+    void begin()
+    {
+    }
+    void end()
+    {
+    }
+    void beginTransaction(SPISettings)
+    {
+    }
+    void endTransaction()
+    {
+    }
+    uint8_t transfer(uint8_t data)
+    {
+        return data;
+    }
+    void transfer(void*, size_t)
+    {
+    }
+};
+
+extern SPIClass SPI;
+
+#endif // __HOST_SPI_H__
@@ -0,0 +1,9 @@
+#ifndef __HOST_WIRE_H__
+#define __HOST_WIRE_H__
+
+#include <Arduino.h>
+
+// the library is a template on the wire, the host sketches bring their own
+// simulated TwoWire
+
+#endif // __HOST_WIRE_H__
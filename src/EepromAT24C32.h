@@ -1,22 +1,36 @@
 #ifndef __EEPROMAT24C32_H__
 #define __EEPROMAT24C32_H__
 
+#include <Arduino.h>
+
+#include "RtcUtility.h"
+
 //I2C Slave Address  
 const uint8_t AT24C32_ADDRESS = 0x50; // 0b0 1010 A2 A1 A0
 
+const uint16_t AT24C32_SIZE = 4096;
+const uint8_t AT24C32_PAGE_SIZE = 32;
+// the self timed write cycle (tWR) is at most 10ms at 5V and 20ms at 2.7V
+const uint8_t AT24C32_WRITE_CYCLE_TIMEOUT_MS = 20;
+
 template<typename T_WIRE_METHOD> class EepromAt24c32
 {
 public:
     EepromAt24c32(T_WIRE_METHOD& wire, uint8_t addressBits = 0b111) :
         _address(AT24C32_ADDRESS | (addressBits & 0b00000111)),
         _wire(wire),
-        _lastError(0)
+        _lastError(0),
+        _isWriteCycleActive(false),
+        _writeCycleStart(0),
+        _isReadAddressKnown(false),
+        _readAddress(0)
     {
     }
 
     void Begin()
     {
         _wire.begin();
+        _isReadAddressKnown = false;
     }
 
     uint8_t LastError()
@@ -38,50 +52,111 @@ public:
         return value;
     }
 
-    // note: this method will write within a single page of eeprom.
-    // Pages are 32 bytes (5 bits), so writing past a page boundary will
-    // just wrap within the page of the starting memory address.  
-    // 
-    // xxxppppp pppaaaaa => p = page #, a = address within the page
+    // Writes split on the 32 byte pages and on the Wire send buffer, which
+    // also has to hold the 2 byte memory address, so any length can be
+    // written from any address.
+    //
+    // xxxxpppp pppaaaaa => p = page #, a = address within the page
     //
-    // NOTE: hardware WIRE libraries often have a limit of a 32 byte send buffer.  The 
-    // effect of this is that only 30 bytes can be sent, 2 bytes for the address to write to,
-    // and then 30 bytes of the actual data. 
-    uint8_t SetMemory(uint16_t memoryAddress, const uint8_t* pValue, uint8_t countBytes)
+    // The device is busy for a write cycle after each page is sent, rather
+    // than waiting a fixed time the device address is polled until it
+    // acknowledges again.  The last write cycle is only waited for by the
+    // next access, so the caller is free in the meantime.
+    uint16_t SetMemory(uint16_t memoryAddress, const uint8_t* pValue, uint16_t countBytes)
     {
-        uint8_t countWritten = 0;
+        uint16_t countWritten = 0;
+
+        while (countBytes) {
+            uint8_t countChunk = AT24C32_PAGE_SIZE - (memoryAddress % AT24C32_PAGE_SIZE);
+            if (countChunk > RTC_WIRE_BUFFER_SIZE - 2)
+                countChunk = RTC_WIRE_BUFFER_SIZE - 2;
+            if (countChunk > countBytes)
+                countChunk = countBytes;
+
+            if (!waitForWriteCycle()) break;
+
+            // the write moves the address the device reads from next
+            _isReadAddressKnown = false;
+            beginTransmission(memoryAddress);
+            for (uint8_t index = 0; index < countChunk; index++)
+                _wire.write(pValue[index]);
 
-        beginTransmission(memoryAddress);
+            _lastError = _wire.endTransmission();
+            if (_lastError) break;
 
-        while (countBytes--) {
-            _wire.write(*pValue++);
-            delay(10); // per spec, memory writes
-            ++countWritten;
+            _isWriteCycleActive = true;
+            _writeCycleStart = millis();
+
+            memoryAddress += countChunk;
+            pValue += countChunk;
+            countBytes -= countChunk;
+            countWritten += countChunk;
         }
 
-        _lastError = _wire.endTransmission();
-        
         return countWritten;
     }
 
+    // true once the last write cycle has completed, does not wait
+    bool IsWriteCycleComplete()
+    {
+        if (_isWriteCycleActive && isAcknowledged())
+            _isWriteCycleActive = false;
+
+        return !_isWriteCycleActive;
+    }
+
     // reading data does not wrap within pages, but due to only using
     // 12 (32K) or 13 (64K) bits are used, they will wrap within the memory limits
     // of the installed EEPROM
     //
-    // NOTE: hardware WIRE libraries may have a limit of a 32 byte recieve buffer.  The 
-    // effect of this is that only 32 bytes can be read at one time.
-    uint8_t GetMemory(uint16_t memoryAddress, uint8_t* pValue, uint8_t countBytes)
+    // Any length can be read, hardware WIRE libraries may have a limit of a 32 
+    // byte recieve buffer so the read is requested in chunks of 
+    // RTC_WIRE_BUFFER_SIZE.  The device continues from the address following the
+    // last byte read, so the address is only sent when it is not already there.
+    uint16_t GetMemory(uint16_t memoryAddress, uint8_t* pValue, uint16_t countBytes)
+    {
+        if (!startRead(memoryAddress)) return 0;
+
+        uint16_t countRead = 0;
+
+        while (countBytes) {
+            uint8_t countChunk = (countBytes < RTC_WIRE_BUFFER_SIZE) ? countBytes : RTC_WIRE_BUFFER_SIZE;
+            uint8_t countChunkRead = readChunk(pValue, countChunk);
+
+            countRead += countChunkRead;
+            if (countChunkRead != countChunk) break;
+
+            pValue += countChunk;
+            countBytes -= countChunk;
+        }
+
+        return countRead;
+    }
+
+    // Reads like GetMemory but hands each chunk to the callback rather than
+    // needing a buffer for all of it
+    //
+    // callback(const uint8_t* pValue, uint8_t countBytes)
+    template<typename T_CALLBACK> uint16_t StreamMemory(uint16_t memoryAddress, 
+        uint16_t countBytes, 
+        T_CALLBACK callback)
     {
-        // set address to read from
-        beginTransmission(memoryAddress);
+        if (!startRead(memoryAddress)) return 0;
 
-        _lastError = _wire.endTransmission();
-        if (_lastError) return 0;
+        uint8_t buffer[RTC_WIRE_BUFFER_SIZE];
+        uint16_t countRead = 0;
 
-        // read the data
-        uint8_t countRead = countBytes = _wire.requestFrom(_address, countBytes);
+        while (countBytes) {
+            uint8_t countChunk = (countBytes < RTC_WIRE_BUFFER_SIZE) ? countBytes : RTC_WIRE_BUFFER_SIZE;
+            uint8_t countChunkRead = readChunk(buffer, countChunk);
 
-        while (countBytes--) *pValue++ = _wire.read();
+            if (countChunkRead) callback(buffer, countChunkRead);
+
+            countRead += countChunkRead;
+            if (countChunkRead != countChunk) break;
+
+            countBytes -= countChunk;
+        }
 
         return countRead;
     }
@@ -91,7 +166,82 @@ private:
     
     T_WIRE_METHOD& _wire;
     uint8_t _lastError;
-    
+
+    bool _isWriteCycleActive;
+    uint32_t _writeCycleStart;
+
+    // where the device will continue a read from, forgotten on any error
+    // as the device may then have moved on without us
+    bool _isReadAddressKnown;
+    uint16_t _readAddress;
+
+    // the device does not acknowledge its address during a write cycle
+    bool isAcknowledged()
+    {
+        _wire.beginTransmission(_address);
+        return (_wire.endTransmission() == 0);
+    }
+
+    bool waitForWriteCycle()
+    {
+        while (_isWriteCycleActive) {
+            // the time is taken before the poll, so time lost between the
+            // two does not fail a write cycle that completed meanwhile
+            bool isExpired = (millis() - _writeCycleStart > AT24C32_WRITE_CYCLE_TIMEOUT_MS);
+
+            if (isAcknowledged()) {
+                _isWriteCycleActive = false;
+            }
+            else if (isExpired) {
+                _lastError = c_RtcWireTimeoutError;
+                _isReadAddressKnown = false;
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool startRead(uint16_t memoryAddress)
+    {
+        if (!waitForWriteCycle()) return false;
+
+        // the device only decodes the low 12 bits
+        memoryAddress %= AT24C32_SIZE;
+        if (!_isReadAddressKnown || _readAddress != memoryAddress) {
+            // set address to read from
+            beginTransmission(memoryAddress);
+
+            _lastError = _wire.endTransmission();
+            if (_lastError) {
+                _isReadAddressKnown = false;
+                return false;
+            }
+
+            _isReadAddressKnown = true;
+            _readAddress = memoryAddress;
+        }
+
+        return true;
+    }
+
+    uint8_t readChunk(uint8_t* pValue, uint8_t countBytes)
+    {
+        uint8_t countRead = _wire.requestFrom(_address, countBytes);
+
+        for (uint8_t index = 0; index < countRead; index++)
+            pValue[index] = _wire.read();
+
+        // the address rolls over from the last byte to the first
+        _readAddress = (_readAddress + countRead) % AT24C32_SIZE;
+        if (countRead != countBytes) {
+            _isReadAddressKnown = false;
+            _lastError = 4;
+        }
+
+        return countRead;
+    }
+
     void beginTransmission(uint16_t memoryAddress)
     {
         _wire.beginTransmission(_address);
@@ -0,0 +1,260 @@
+#ifndef __EEPROMAT24C32CACHE_H__
+#define __EEPROMAT24C32CACHE_H__
+
+#include <Arduino.h>
+
+#include "EepromAT24C32.h"
+
+const uint16_t c_EepromCachePageNone = 0xffff;
+
+// A write back cache of whole 32 byte pages in front of an EepromAt24c32.
+// Writes only change the cached page and mark the range written as dirty,
+// so many small writes to a page cost a single write cycle when the page is
+// flushed.  The least recently used page is flushed when its slot is needed,
+// everything else waits for Flush(), so call it before power may be lost.
+//
+// EepromAt24c32<TwoWire> Eeprom(Wire);
+// EepromAt24c32Cache<TwoWire, 2> Cache(Eeprom);
+template<typename T_WIRE_METHOD, uint8_t V_PAGE_COUNT = 2> class EepromAt24c32Cache
+{
+public:
+    EepromAt24c32Cache(EepromAt24c32<T_WIRE_METHOD>& eeprom) :
+        _eeprom(eeprom),
+        _useCount(0)
+    {
+        Invalidate();
+        ResetStatistics();
+    }
+
+    uint8_t LastError()
+    {
+        return _eeprom.LastError();
+    }
+
+    void SetMemory(uint16_t memoryAddress, uint8_t value)
+    {
+        SetMemory(memoryAddress, &value, 1);
+    }
+
+    uint8_t GetMemory(uint16_t memoryAddress)
+    {
+        uint8_t value = 0;
+
+        GetMemory(memoryAddress, &value, 1);
+
+        return value;
+    }
+
+    uint16_t SetMemory(uint16_t memoryAddress, const uint8_t* pValue, uint16_t countBytes)
+    {
+        uint16_t countWritten = 0;
+
+        while (countBytes) {
+            uint8_t offset = memoryAddress % AT24C32_PAGE_SIZE;
+            uint8_t countChunk = AT24C32_PAGE_SIZE - offset;
+            if (countChunk > countBytes)
+                countChunk = countBytes;
+
+            // a whole page written does not need to be read first
+            CachePage* pPage = findPage(pageOf(memoryAddress), countChunk == AT24C32_PAGE_SIZE);
+            if (pPage == NULL) break;
+
+            for (uint8_t index = offset; index < offset + countChunk; index++, pValue++) {
+                // unchanged bytes are not written again
+                if (pPage->data[index] != *pValue) {
+                    pPage->data[index] = *pValue;
+                    markDirty(pPage, index);
+                }
+            }
+
+            _pageWritesRequested += writeCycles(countChunk);
+
+            memoryAddress += countChunk;
+            countBytes -= countChunk;
+            countWritten += countChunk;
+        }
+
+        return countWritten;
+    }
+
+    uint16_t GetMemory(uint16_t memoryAddress, uint8_t* pValue, uint16_t countBytes)
+    {
+        uint16_t countRead = 0;
+
+        while (countBytes) {
+            uint8_t offset = memoryAddress % AT24C32_PAGE_SIZE;
+            uint8_t countChunk = AT24C32_PAGE_SIZE - offset;
+            if (countChunk > countBytes)
+                countChunk = countBytes;
+
+            CachePage* pPage = findPage(pageOf(memoryAddress), false);
+            if (pPage == NULL) break;
+
+            memcpy(pValue, pPage->data + offset, countChunk);
+
+            pValue += countChunk;
+            memoryAddress += countChunk;
+            countBytes -= countChunk;
+            countRead += countChunk;
+        }
+
+        return countRead;
+    }
+
+    // writes all the dirty pages, false if any could not be written
+    bool Flush()
+    {
+        bool isFlushed = true;
+
+        for (uint8_t index = 0; index < V_PAGE_COUNT; index++) {
+            isFlushed &= flushPage(&_pages[index]);
+        }
+
+        return isFlushed;
+    }
+
+    // drops all the cached pages, any dirty data is lost
+    void Invalidate()
+    {
+        for (uint8_t index = 0; index < V_PAGE_COUNT; index++) {
+            _pages[index].page = c_EepromCachePageNone;
+            _pages[index].dirtyStart = AT24C32_PAGE_SIZE;
+            _pages[index].dirtyEnd = 0;
+        }
+    }
+
+    uint32_t CacheHits()
+    {
+        return _cacheHits;
+    }
+
+    uint32_t CacheMisses()
+    {
+        return _cacheMisses;
+    }
+
+    // the page write cycles actually used
+    uint32_t PageWrites()
+    {
+        return _pageWrites;
+    }
+
+    // the page write cycles the same calls would have used without the cache
+    uint32_t PageWritesSaved()
+    {
+        return (_pageWritesRequested > _pageWrites) ? _pageWritesRequested - _pageWrites : 0;
+    }
+
+    void ResetStatistics()
+    {
+        _cacheHits = 0;
+        _cacheMisses = 0;
+        _pageWrites = 0;
+        _pageWritesRequested = 0;
+    }
+
+private:
+    struct CachePage
+    {
+        uint16_t page;
+        uint8_t dirtyStart; // dirtyStart >= dirtyEnd when clean
+        uint8_t dirtyEnd;
+        uint32_t lastUse;
+        uint8_t data[AT24C32_PAGE_SIZE];
+    };
+
+    EepromAt24c32<T_WIRE_METHOD>& _eeprom;
+    CachePage _pages[V_PAGE_COUNT];
+    uint32_t _useCount;
+
+    uint32_t _cacheHits;
+    uint32_t _cacheMisses;
+    uint32_t _pageWrites;
+    uint32_t _pageWritesRequested;
+
+    // the Wire send buffer also holds the memory address, so a full page
+    // takes more than one write
+    static uint8_t writeCycles(uint8_t countBytes)
+    {
+        const uint8_t countPerWrite = RTC_WIRE_BUFFER_SIZE - 2;
+
+        return (countBytes + countPerWrite - 1) / countPerWrite;
+    }
+
+    static bool isDirty(const CachePage* pPage)
+    {
+        return (pPage->dirtyStart < pPage->dirtyEnd);
+    }
+
+    static void markDirty(CachePage* pPage, uint8_t index)
+    {
+        if (index < pPage->dirtyStart)
+            pPage->dirtyStart = index;
+        if (index >= pPage->dirtyEnd)
+            pPage->dirtyEnd = index + 1;
+    }
+
+    bool flushPage(CachePage* pPage)
+    {
+        if (!isDirty(pPage)) return true;
+
+        uint8_t countBytes = pPage->dirtyEnd - pPage->dirtyStart;
+        uint16_t memoryAddress = pPage->page * AT24C32_PAGE_SIZE + pPage->dirtyStart;
+
+        if (_eeprom.SetMemory(memoryAddress, pPage->data + pPage->dirtyStart, countBytes) != countBytes)
+            return false;
+
+        pPage->dirtyStart = AT24C32_PAGE_SIZE;
+        pPage->dirtyEnd = 0;
+        _pageWrites += writeCycles(countBytes);
+        return true;
+    }
+
+    // the memory wraps within AT24C32_SIZE, so an address beyond it is the
+    // same page as the one it aliases
+    static uint16_t pageOf(uint16_t memoryAddress)
+    {
+        return (memoryAddress % AT24C32_SIZE) / AT24C32_PAGE_SIZE;
+    }
+
+    CachePage* findPage(uint16_t page, bool isOverwrite)
+    {
+        CachePage* pVictim = &_pages[0];
+
+        for (uint8_t index = 0; index < V_PAGE_COUNT; index++) {
+            CachePage* pPage = &_pages[index];
+
+            if (pPage->page == page) {
+                _cacheHits++;
+                pPage->lastUse = ++_useCount;
+                return pPage;
+            }
+
+            // an empty slot is taken before the least recently used
+            if (pVictim->page != c_EepromCachePageNone &&
+                (pPage->page == c_EepromCachePageNone || pPage->lastUse < pVictim->lastUse)) {
+                pVictim = pPage;
+            }
+        }
+
+        _cacheMisses++;
+
+        if (!flushPage(pVictim)) return NULL;
+
+        if (isOverwrite) {
+            // every byte will be written
+            pVictim->dirtyStart = 0;
+            pVictim->dirtyEnd = AT24C32_PAGE_SIZE;
+        }
+        else if (_eeprom.GetMemory(page * AT24C32_PAGE_SIZE, pVictim->data, AT24C32_PAGE_SIZE) != AT24C32_PAGE_SIZE) {
+            pVictim->page = c_EepromCachePageNone;
+            return NULL;
+        }
+
+        pVictim->page = page;
+        pVictim->lastUse = ++_useCount;
+        return pVictim;
+    }
+};
+
+#endif // __EEPROMAT24C32CACHE_H__
@@ -0,0 +1,412 @@
+#ifndef __EEPROMAT24C32EVENTLOG_H__
+#define __EEPROMAT24C32EVENTLOG_H__
+
+#include <Arduino.h>
+
+#include "RtcUtility.h"
+#include "RtcDateTime.h"
+#include "EepromAT24C32.h"
+
+// erased memory reads as 0xff, so this marks an unused record
+const uint32_t c_EventLogSequenceNone = 0xffffffff;
+// the sequence, the time and then the CRC of the record
+const uint8_t c_EventLogRecordCrcOffset = 8;
+const uint8_t c_EventLogRecordHeaderSize = 9;
+// the CRCs start from this so that zeroed memory is not a record
+const uint8_t c_EventLogCrcSeed = 0x5a;
+
+// A circular log of fixed size records kept in a region of an AT24C32.
+//
+// Each record holds its sequence number, the TotalSeconds() it was logged
+// at, a CRC over the rest of the record and V_RECORD_SIZE - 9 bytes of
+// payload.  The record sizes divide the page size so an append never
+// crosses a page, and there is no header to rewrite, the record with
+// sequence n always lives in slot n % slot count.  A 16 byte record is a
+// single write cycle, a 32 byte record is more than the Wire buffer holds
+// and takes two, so a torn append can leave the new header over the old
+// payload, the CRC finds either.  Begin() finds the newest record with a
+// binary search over the sequence numbers, then checks the record it found
+// and its time against the one before.  A torn append breaks the run of
+// sequences the search relies on, so Begin() reads every slot then.
+//
+// The region must start on a page boundary and hold at least one record,
+// otherwise the log has no slots and Begin(), Format() and Append() fail.
+// It should be Format()ed once before first use.
+//
+// EepromAt24c32EventLog<TwoWire, 16> Log(Eeprom, 0, 1024); // 64 records
+template<typename T_WIRE_METHOD, uint8_t V_RECORD_SIZE = 16> class EepromAt24c32EventLog
+{
+public:
+    static_assert(V_RECORD_SIZE > c_EventLogRecordHeaderSize && (AT24C32_PAGE_SIZE % V_RECORD_SIZE) == 0,
+        "the record size must be 16 or 32");
+
+    static const uint8_t PayloadSize = V_RECORD_SIZE - c_EventLogRecordHeaderSize;
+
+    EepromAt24c32EventLog(EepromAt24c32<T_WIRE_METHOD>& eeprom,
+            uint16_t startAddress = 0,
+            uint16_t countBytes = AT24C32_SIZE) :
+        _eeprom(eeprom),
+        _startAddress(startAddress),
+        // a record off a page boundary could be split over two pages
+        _slotCount((startAddress % AT24C32_PAGE_SIZE) ? 0 : countBytes / V_RECORD_SIZE),
+        _headSlot(0),
+        _count(0),
+        _nextSequence(0)
+    {
+    }
+
+    uint8_t LastError()
+    {
+        return _eeprom.LastError();
+    }
+
+    // finds the head and tail of the log already in memory, false when the
+    // region holds no record or the memory could not be read
+    bool Begin()
+    {
+        uint8_t record[V_RECORD_SIZE];
+
+        _headSlot = 0;
+        _count = 0;
+        _nextSequence = 0;
+
+        if (_slotCount == 0) return false;
+        if (!readRecord(0, record)) return false;
+
+        uint32_t first = getUint32(record);
+
+        if (first == c_EventLogSequenceNone) {
+            // a torn append over slot 0 can read as unused too, but then
+            // the log had wrapped and the last slot is in use
+            uint32_t last;
+
+            if (!readSequence(_slotCount - 1, &last)) return false;
+            if (last == c_EventLogSequenceNone) return true; // empty
+            return scan();
+        }
+        if (!isWhole(0, record)) return scan();
+
+        // slots [0, head) hold first, first + 1, ... and the slot at the
+        // head is either unused or holds an older record
+        uint16_t low = 1;
+        uint16_t high = _slotCount;
+
+        while (low < high) {
+            uint16_t middle = low + (high - low) / 2;
+            uint32_t sequence;
+
+            if (!readSequence(middle, &sequence)) return false;
+
+            if (sequence == first + middle) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        if (!readRecord(low - 1, record)) return false;
+        if (!isWhole(low - 1, record)) return scan();
+
+        uint32_t newest = getUint32(record);
+        bool isInOrder;
+
+        if (!isAfterPrevious(newest, getUint32(record + 4), &isInOrder)) return false;
+        if (!isInOrder) return scan();
+
+        return setNewest(newest);
+    }
+
+    // erases the whole region, a page write for every page in it
+    bool Format()
+    {
+        uint8_t erased[AT24C32_PAGE_SIZE];
+        uint16_t countBytes = _slotCount * V_RECORD_SIZE;
+
+        if (_slotCount == 0) return false;
+
+        memset(erased, 0xff, sizeof(erased));
+
+        for (uint16_t offset = 0; offset < countBytes; offset += AT24C32_PAGE_SIZE) {
+            if (_eeprom.SetMemory(_startAddress + offset, erased, sizeof(erased)) != sizeof(erased))
+                return false;
+        }
+
+        _headSlot = 0;
+        _count = 0;
+        _nextSequence = 0;
+        return true;
+    }
+
+    // payload beyond PayloadSize is dropped, a short payload is padded with 0xff
+    bool Append(const RtcDateTime& time, const uint8_t* pPayload, uint8_t countBytes)
+    {
+        uint8_t record[V_RECORD_SIZE];
+
+        if (_slotCount == 0) return false;
+
+        if (countBytes > PayloadSize) {
+            countBytes = PayloadSize;
+        }
+
+        memset(record, 0xff, sizeof(record));
+        setUint32(record, _nextSequence);
+        setUint32(record + 4, time.TotalSeconds());
+        memcpy(record + c_EventLogRecordHeaderSize, pPayload, countBytes);
+        record[c_EventLogRecordCrcOffset] = recordCrc(record);
+
+        if (_eeprom.SetMemory(slotAddress(_headSlot), record, V_RECORD_SIZE) != V_RECORD_SIZE)
+            return false;
+
+        _nextSequence++;
+        _headSlot = (_headSlot + 1) % _slotCount;
+        if (_count < _slotCount) {
+            _count++;
+        }
+        return true;
+    }
+
+    uint16_t Count() const
+    {
+        return _count;
+    }
+
+    uint16_t Capacity() const
+    {
+        return _slotCount;
+    }
+
+    // the oldest record still in the log
+    uint32_t FirstSequence() const
+    {
+        return _nextSequence - _count;
+    }
+
+    // the sequence the next Append will use
+    uint32_t NextSequence() const
+    {
+        return _nextSequence;
+    }
+
+    // pPayload must hold PayloadSize bytes
+    bool GetRecord(uint32_t sequence, RtcDateTime* pTime, uint8_t* pPayload)
+    {
+        if (sequence < FirstSequence() || sequence >= _nextSequence) return false;
+
+        uint8_t record[V_RECORD_SIZE];
+
+        if (!readRecord(sequence % _slotCount, record)) return false;
+        if (getUint32(record) != sequence || !isWhole(sequence % _slotCount, record))
+            return false;
+
+        *pTime = RtcDateTime(getUint32(record + 4));
+        memcpy(pPayload, record + c_EventLogRecordHeaderSize, PayloadSize);
+        return true;
+    }
+
+    // the first record logged at or after the time, NextSequence() if none,
+    // records are expected to be appended in time order
+    uint32_t FindSequence(const RtcDateTime& time)
+    {
+        uint32_t seconds = time.TotalSeconds();
+        uint32_t low = FirstSequence();
+        uint32_t high = _nextSequence;
+
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            uint8_t timestamp[4];
+
+            if (_eeprom.GetMemory(slotAddress(middle % _slotCount) + 4, timestamp, sizeof(timestamp)) != sizeof(timestamp))
+                return _nextSequence;
+
+            if (getUint32(timestamp) < seconds) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        return low;
+    }
+
+    // calls back for each record logged from start up to and including end
+    //
+    // callback(uint32_t sequence, const RtcDateTime& time, const uint8_t* pPayload)
+    template<typename T_CALLBACK> uint16_t ForEachInRange(const RtcDateTime& start,
+        const RtcDateTime& end,
+        T_CALLBACK callback)
+    {
+        uint16_t countFound = 0;
+        uint8_t payload[PayloadSize];
+        RtcDateTime time;
+
+        for (uint32_t sequence = FindSequence(start); sequence < _nextSequence; sequence++) {
+            if (!GetRecord(sequence, &time, payload)) break;
+            if (time.TotalSeconds() > end.TotalSeconds()) break;
+
+            callback(sequence, time, payload);
+            countFound++;
+        }
+
+        return countFound;
+    }
+
+private:
+    EepromAt24c32<T_WIRE_METHOD>& _eeprom;
+    const uint16_t _startAddress;
+    const uint16_t _slotCount;
+
+    uint16_t _headSlot;
+    uint16_t _count;
+    uint32_t _nextSequence;
+
+    uint16_t slotAddress(uint16_t slot) const
+    {
+        return _startAddress + slot * V_RECORD_SIZE;
+    }
+
+    bool readSequence(uint16_t slot, uint32_t* pSequence)
+    {
+        uint8_t sequence[4];
+
+        if (_eeprom.GetMemory(slotAddress(slot), sequence, sizeof(sequence)) != sizeof(sequence))
+            return false;
+
+        *pSequence = getUint32(sequence);
+        return true;
+    }
+
+    bool readHeader(uint16_t slot, uint32_t* pSequence, uint32_t* pSeconds)
+    {
+        uint8_t header[c_EventLogRecordHeaderSize];
+
+        if (_eeprom.GetMemory(slotAddress(slot), header, sizeof(header)) != sizeof(header))
+            return false;
+
+        *pSequence = getUint32(header);
+        *pSeconds = getUint32(header + 4);
+        return true;
+    }
+
+    bool readRecord(uint16_t slot, uint8_t* pRecord)
+    {
+        return (_eeprom.GetMemory(slotAddress(slot), pRecord, V_RECORD_SIZE) == V_RECORD_SIZE);
+    }
+
+    // a record holds the sequence of its own slot and the CRC of what was
+    // written with it
+    bool isWhole(uint16_t slot, const uint8_t* pRecord) const
+    {
+        uint32_t sequence = getUint32(pRecord);
+
+        return (sequence != c_EventLogSequenceNone &&
+            (sequence % _slotCount) == slot &&
+            pRecord[c_EventLogRecordCrcOffset] == recordCrc(pRecord));
+    }
+
+    // over the whole record but the CRC itself
+    static uint8_t recordCrc(const uint8_t* pRecord)
+    {
+        uint8_t crc = RtcCrc8(pRecord, c_EventLogRecordCrcOffset, c_EventLogCrcSeed);
+
+        return RtcCrc8(pRecord + c_EventLogRecordHeaderSize, PayloadSize, crc);
+    }
+
+    // a torn append can leave the new sequence over the time of the record
+    // it replaced, which is older than the record before it
+    bool isAfterPrevious(uint32_t sequence, uint32_t seconds, bool* pIsInOrder)
+    {
+        uint32_t previous;
+        uint32_t previousSeconds;
+
+        *pIsInOrder = true;
+        if (sequence == 0 || _slotCount == 1) return true;
+
+        if (!readHeader((sequence - 1) % _slotCount, &previous, &previousSeconds)) return false;
+        if (previous == sequence - 1) {
+            *pIsInOrder = (seconds >= previousSeconds);
+        }
+        return true;
+    }
+
+    // reads every slot, for when the sequences do not run on from slot 0,
+    // and keeps the newest whole record that is in time order
+    bool scan()
+    {
+        uint32_t newest = 0;
+        uint32_t newestSeconds = 0;
+        uint32_t previous = 0;
+        uint32_t previousSeconds = 0;
+        bool hasNewest = false;
+        bool hasPrevious = false;
+
+        for (uint16_t slot = 0; slot < _slotCount; slot++) {
+            uint8_t record[V_RECORD_SIZE];
+
+            if (!readRecord(slot, record)) return false;
+            if (!isWhole(slot, record)) continue;
+
+            uint32_t sequence = getUint32(record);
+            uint32_t seconds = getUint32(record + 4);
+
+            if (!hasNewest || sequence > newest) {
+                previous = newest;
+                previousSeconds = newestSeconds;
+                hasPrevious = hasNewest;
+                newest = sequence;
+                newestSeconds = seconds;
+                hasNewest = true;
+            }
+            else if (!hasPrevious || sequence > previous) {
+                previous = sequence;
+                previousSeconds = seconds;
+                hasPrevious = true;
+            }
+        }
+
+        if (!hasNewest) return true; // empty
+
+        if (hasPrevious && previous == newest - 1 && newestSeconds < previousSeconds) {
+            newest = previous;
+        }
+        return setNewest(newest);
+    }
+
+    // the slot after the newest holds the oldest record once the log has
+    // wrapped, unless that was lost to a torn append
+    bool setNewest(uint32_t newest)
+    {
+        _nextSequence = newest + 1;
+        _headSlot = _nextSequence % _slotCount;
+
+        if (newest < _slotCount) {
+            _count = _nextSequence;
+            return true;
+        }
+
+        uint32_t oldest;
+
+        if (!readSequence(_headSlot, &oldest)) return false;
+        _count = (oldest == _nextSequence - _slotCount) ? _slotCount : _slotCount - 1;
+        return true;
+    }
+
+    static void setUint32(uint8_t* pValue, uint32_t value)
+    {
+        pValue[0] = value;
+        pValue[1] = value >> 8;
+        pValue[2] = value >> 16;
+        pValue[3] = value >> 24;
+    }
+
+    static uint32_t getUint32(const uint8_t* pValue)
+    {
+        return pValue[0] |
+            (static_cast<uint32_t>(pValue[1]) << 8) |
+            (static_cast<uint32_t>(pValue[2]) << 16) |
+            (static_cast<uint32_t>(pValue[3]) << 24);
+    }
+};
+
+#endif // __EEPROMAT24C32EVENTLOG_H__
@@ -0,0 +1,179 @@
+#ifndef __RTC32KHZCAPTURE_H__
+#define __RTC32KHZCAPTURE_H__
+
+#include <Arduino.h>
+
+#include "RtcUtility.h"
+#include "RtcTimestamp.h"
+#include "RtcTickClock.h"
+
+// Counts the edges of the 32kHz output in software, call Edge() from the
+// interrupt for the pin.  That is 32768 interrupts a second, so this is meant
+// for the faster platforms like the ESP32.
+class Rtc32kHzInterruptCounter
+{
+public:
+    Rtc32kHzInterruptCounter() :
+        _count(0)
+    {
+    }
+
+    void Begin()
+    {
+    }
+
+    void ISR_ATTR Edge()
+    {
+        _count = _count + 1;
+    }
+
+    uint16_t Read()
+    {
+        uint16_t count;
+
+        // the two bytes may be read either side of an edge on AVR
+        do {
+            count = _count;
+        } while (count != _count);
+
+        return count;
+    }
+
+private:
+    volatile uint16_t _count;
+};
+
+#if defined(ARDUINO_ARCH_AVR) && defined(TCNT1)
+
+// Counts the edges of the 32kHz output in hardware with Timer1 clocked from
+// its T1 pin (D5 on the Uno, D12 on the Leonardo, D47 on the Mega), so it
+// costs no interrupts.  Timer1 is then not available to other libraries
+// such as Servo.
+class Rtc32kHzTimer1Counter
+{
+public:
+    void Begin()
+    {
+        uint8_t sreg = SREG;
+        cli();
+
+        TCCR1A = 0;
+        TCCR1B = _BV(CS12) | _BV(CS11) | _BV(CS10); // external clock on T1, rising edge
+        TCNT1 = 0;
+
+        SREG = sreg;
+    }
+
+    uint16_t Read()
+    {
+        // the 16 bit read goes through the shared TEMP register, which a
+        // read from an interrupt would overwrite
+        uint8_t sreg = SREG;
+        cli();
+        uint16_t count = TCNT1;
+        SREG = sreg;
+
+        return count;
+    }
+};
+
+#endif
+
+// Sub-second timestamps from the 32kHz output of the RTC (Enable32kHzPin on
+// the DS3231 and DS3234), counted by a T_COUNTER such as
+// Rtc32kHzTimer1Counter or Rtc32kHzInterruptCounter.  The DS1307 has a
+// single output pin and cannot give the 32kHz and 1Hz outputs at once.
+//
+// The 1Hz square wave and the 32kHz output come from the same divider, so
+// the count is taken at each second tick and the edges counted since then are
+// the fraction of the current second.  Taking a timestamp reads the counter
+// and never uses the bus, it may be called from an interrupt.
+//
+// Call Tick() from the interrupt for the falling edge of the 1Hz square wave,
+// as with RtcTickClock, and Begin() once both are running.
+template<typename T_COUNTER> class Rtc32kHzCapture
+{
+public:
+    Rtc32kHzCapture(T_COUNTER& counter) :
+        _counter(counter),
+        _seconds(0),
+        _tickCount(0),
+        _hasTick(false),
+        _isLocked(false)
+    {
+    }
+
+    template<typename T_RTC> void Begin(T_RTC& rtc)
+    {
+        _counter.Begin();
+
+        uint32_t seconds = _sequence.ReadRtcSeconds(rtc);
+
+        write(seconds, _tickCount);
+        _hasTick = false;
+        _isLocked = false;
+        interrupts();
+    }
+
+    void ISR_ATTR Tick()
+    {
+        uint16_t count = _counter.Read();
+
+        // a second is exactly 32768 edges when none were missed
+        _isLocked = _hasTick && (static_cast<uint16_t>(count - _tickCount) == c_RtcTimestampFractionsPerSecond);
+        _hasTick = true;
+
+        write(_seconds + 1, count);
+    }
+
+    // true once a whole second was counted with no edges missed, until then
+    // the fraction is not known
+    bool IsLocked() const
+    {
+        return _isLocked;
+    }
+
+    RtcTimestamp Capture()
+    {
+        uint8_t sequence;
+        uint32_t seconds;
+        uint16_t tickCount;
+        uint16_t count;
+        bool hasTick;
+
+        // the count is read inside so it is never before the tick it is
+        // measured from
+        do {
+            sequence = _sequence.BeginRead();
+            seconds = _seconds;
+            tickCount = _tickCount;
+            hasTick = _hasTick;
+            count = _counter.Read();
+        } while (_sequence.IsReadTorn(sequence));
+
+        if (!hasTick) return RtcTimestamp(seconds);
+
+        // past 32767 the next tick is still pending, the timestamp moves
+        // into the next second
+        return RtcTimestamp(seconds, count - tickCount);
+    }
+
+private:
+    T_COUNTER& _counter;
+
+    RtcTickSequence _sequence;
+    volatile uint32_t _seconds;
+    volatile uint16_t _tickCount; // the count at the start of _seconds
+    volatile bool _hasTick;
+    volatile bool _isLocked;
+
+    void ISR_ATTR write(uint32_t seconds, uint16_t tickCount)
+    {
+        _sequence.BeginWrite();
+        _seconds = seconds;
+        _tickCount = tickCount;
+        _sequence.EndWrite();
+    }
+};
+
+#endif // __RTC32KHZCAPTURE_H__
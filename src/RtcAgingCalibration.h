@@ -0,0 +1,183 @@
+#ifndef __RTCAGINGCALIBRATION_H__
+#define __RTCAGINGCALIBRATION_H__
+
+#include <Arduino.h>
+
+#include "RtcTimestamp.h"
+
+// the memory store key the calibration is kept under by default
+const uint8_t c_RtcAgingCalibrationKey = 0xa0;
+// an aging offset LSB moves the frequency by about 0.1ppm at 25C, a positive
+// offset slows the clock
+const float c_RtcAgingPpmPerStep = 0.1f;
+// fewer samples than this give no estimate of the drift
+const uint16_t c_RtcAgingMinSamples = 3;
+// samples between saves, each save is a write to the memory of the store
+const uint8_t c_RtcAgingSaveEverySamples = 8;
+
+// Trims the aging offset of a DS3231 or DS3234 against a reference clock,
+// such as a GPS PPS, NTP or the time of a host.
+//
+// Each sample pairs a reference time with the RTC time at the same moment,
+// both with sub-second resolution, for example from Rtc32kHzCapture taken at
+// the PPS edge.  A least squares line through the offset between them gives
+// the drift in ppm, which is the same as microseconds per second.  The fit
+// is kept as running means and sums rather than samples, and saved to a
+// store such as RtcMemoryStore every saveEverySamples samples and by
+// Apply() and Reset(), so a calibration window of days survives a reset
+// without wearing an EEPROM.  A reset loses the samples since the last
+// save, call Save() before a planned one.
+//
+// RtcMemoryStore<EepromAt24c32<TwoWire>, 48> Store(Eeprom);
+// RtcAgingCalibration<RtcDS3231<TwoWire>, RtcMemoryStore<EepromAt24c32<TwoWire>, 48>> Calibration(Rtc, Store);
+// Store.Begin();
+// Calibration.Begin();
+// ...
+// Calibration.AddSample(gpsTime, Capture.Capture());
+// if (Calibration.IsReady()) Calibration.Apply();
+template<typename T_RTC, typename T_STORE> class RtcAgingCalibration
+{
+public:
+    RtcAgingCalibration(T_RTC& rtc,
+            T_STORE& store,
+            uint32_t windowSeconds = 86400,
+            uint8_t key = c_RtcAgingCalibrationKey,
+            uint8_t saveEverySamples = c_RtcAgingSaveEverySamples) :
+        _rtc(rtc),
+        _store(store),
+        _windowSeconds(windowSeconds),
+        _key(key),
+        _saveEverySamples(saveEverySamples ? saveEverySamples : 1)
+    {
+        clear();
+    }
+
+    // loads the samples so far from the store, call after the Begin() of
+    // the store, false when there were none
+    bool Begin()
+    {
+        if (_store.Get(_key, reinterpret_cast<uint8_t*>(&_state), sizeof(_state)) != sizeof(_state)) {
+            clear();
+            return false;
+        }
+        return true;
+    }
+
+    // reference and rtc are the two clocks read at the same moment, false
+    // when this was a sample that saves and the save failed
+    bool AddSample(const RtcTimestamp& reference, const RtcTimestamp& rtc)
+    {
+        if (_state.count == 0) {
+            _state.firstSeconds = reference.TotalSeconds();
+        }
+
+        // seconds into the window and the RTC offset in microseconds
+        float x = static_cast<float>(reference.TotalSeconds() - _state.firstSeconds) +
+            static_cast<float>(reference.Fraction()) / c_RtcTimestampFractionsPerSecond;
+        float y = static_cast<float>(rtc - reference) * (1000000.0f / c_RtcTimestampFractionsPerSecond);
+
+        // Welford's update, the sums are about the means so they stay
+        // accurate in single precision
+        _state.count++;
+        float dx = x - _state.meanX;
+        _state.meanX += dx / _state.count;
+        _state.meanY += (y - _state.meanY) / _state.count;
+        _state.sumXX += dx * (x - _state.meanX);
+        _state.sumXY += dx * (y - _state.meanY);
+        _state.lastX = x;
+
+        if (_state.count % _saveEverySamples) return true;
+        return Save();
+    }
+
+    // saves the samples so far, as done every saveEverySamples samples
+    bool Save()
+    {
+        return _store.Set(_key, reinterpret_cast<const uint8_t*>(&_state), sizeof(_state));
+    }
+
+    uint16_t SampleCount() const
+    {
+        return _state.count;
+    }
+
+    // the seconds between the first and last samples
+    uint32_t WindowSeconds() const
+    {
+        return static_cast<uint32_t>(_state.lastX);
+    }
+
+    // positive when the RTC runs fast
+    float DriftPpm() const
+    {
+        if (_state.count < 2 || _state.sumXX <= 0.0f) return 0.0f;
+        return _state.sumXY / _state.sumXX;
+    }
+
+    bool IsReady() const
+    {
+        return _state.count >= c_RtcAgingMinSamples && _state.lastX >= _windowSeconds;
+    }
+
+    // the aging offset that would correct the drift
+    int8_t CorrectedAgingOffset()
+    {
+        float steps = DriftPpm() / c_RtcAgingPpmPerStep;
+
+        // beyond the range of the register either way
+        if (steps > 255.0f) steps = 255.0f;
+        if (steps < -255.0f) steps = -255.0f;
+
+        int16_t offset = _rtc.GetAgingOffset() + static_cast<int16_t>(steps + ((steps < 0) ? -0.5f : 0.5f));
+
+        if (offset > 127) offset = 127;
+        if (offset < -128) offset = -128;
+        return offset;
+    }
+
+    // writes the corrected aging offset once the window is complete and
+    // starts a new window, as the drift has changed
+    bool Apply()
+    {
+        if (!IsReady()) return false;
+
+        _rtc.SetAgingOffset(CorrectedAgingOffset());
+        // the offset takes effect with the next temperature conversion
+        _rtc.ForceTemperatureCompensationUpdate(false);
+
+        return Reset();
+    }
+
+    bool Reset()
+    {
+        clear();
+        return Save();
+    }
+
+private:
+    struct State
+    {
+        float meanX;
+        float meanY;
+        float sumXX;
+        float sumXY;
+        float lastX;
+        uint32_t firstSeconds;
+        uint16_t count;
+    };
+
+    T_RTC& _rtc;
+    T_STORE& _store;
+    const uint32_t _windowSeconds;
+    const uint8_t _key;
+    const uint8_t _saveEverySamples;
+
+    State _state;
+
+    void clear()
+    {
+        memset(&_state, 0, sizeof(_state));
+    }
+};
+
+#endif // __RTCAGINGCALIBRATION_H__
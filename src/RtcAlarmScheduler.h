@@ -0,0 +1,258 @@
+#ifndef __RTCALARMSCHEDULER_H__
+#define __RTCALARMSCHEDULER_H__
+
+#include <Arduino.h>
+
+#include "RtcDateTime.h"
+
+// returned by Add when the scheduler is full, and never a valid id
+const uint8_t c_RtcAlarmInvalid = 0xff;
+
+typedef void (*RtcAlarmCallback)(uint8_t id);
+
+// Many software alarms over alarm one of a DS3231 or DS3234, which is
+// always programmed with the earliest deadline.
+//
+// The alarms are kept in a binary min heap on the deadline, with the heap
+// position of each alarm id kept so Remove is O(log n) as is Add.  The bus
+// is only used when the earliest deadline changes and when alarm one fires,
+// call Process() then, as flagged by the interrupt of the alarm pin, and it
+// calls back every alarm that is due.  Alarm two is left to the caller.
+//
+// RtcAlarmScheduler<RtcDS3231<TwoWire>, DS3231AlarmOne> Scheduler(Rtc);
+// Rtc.SetSquareWavePin(DS3231SquareWavePin_ModeAlarmOne);
+// Scheduler.Add(Rtc.GetDateTime().TotalSeconds() + 90, OnAlarm, 3600); // then every hour
+// ...
+// if (interuptFlag) Scheduler.Process();
+template<typename T_RTC, typename T_ALARM_ONE, uint8_t V_CAPACITY = 16> class RtcAlarmScheduler
+{
+public:
+    static_assert(V_CAPACITY < c_RtcAlarmInvalid, "the capacity must leave room for c_RtcAlarmInvalid");
+
+    RtcAlarmScheduler(T_RTC& rtc) :
+        _rtc(rtc),
+        _count(0),
+        _programmed(0),
+        _isProgrammed(false),
+        _isDispatching(false)
+    {
+        for (uint8_t id = 0; id < V_CAPACITY; id++) {
+            _position[id] = c_RtcAlarmInvalid;
+            _free[id] = V_CAPACITY - 1 - id;
+        }
+    }
+
+    // calls back at the deadline, seconds since 2000, and then every
+    // periodSeconds when that is not 0.  A deadline already past is called
+    // back at once.  Returns the id of the alarm or c_RtcAlarmInvalid when
+    // the scheduler is full.
+    uint8_t Add(uint32_t deadline, RtcAlarmCallback callback, uint32_t periodSeconds = 0)
+    {
+        if (_count == V_CAPACITY) return c_RtcAlarmInvalid;
+
+        uint8_t id = _free[V_CAPACITY - 1 - _count];
+
+        _deadline[id] = deadline;
+        _period[id] = periodSeconds;
+        _callback[id] = callback;
+        push(id);
+
+        if (_heap[0] == id) {
+            update();
+        }
+        return id;
+    }
+
+    uint8_t Add(const RtcDateTime& deadline, RtcAlarmCallback callback, uint32_t periodSeconds = 0)
+    {
+        return Add(deadline.TotalSeconds(), callback, periodSeconds);
+    }
+
+    // an alarm removed while it was programmed may still fire, Process()
+    // then finds nothing due and programs the next
+    bool Remove(uint8_t id)
+    {
+        if (id >= V_CAPACITY || _position[id] == c_RtcAlarmInvalid) return false;
+
+        removeAt(_position[id]);
+        release(id);
+        return true;
+    }
+
+    bool IsScheduled(uint8_t id) const
+    {
+        return (id < V_CAPACITY && _position[id] != c_RtcAlarmInvalid);
+    }
+
+    uint8_t Count() const
+    {
+        return _count;
+    }
+
+    // the earliest deadline, 0 when there are no alarms
+    uint32_t NextDeadline() const
+    {
+        return _count ? _deadline[_heap[0]] : 0;
+    }
+
+    // Clears the alarm flags and calls back every alarm that is due, then
+    // programs the next.  Returns the flags that were latched, so alarm two
+    // can still be handled by the caller.
+    uint8_t Process()
+    {
+        uint8_t flags = _rtc.LatchAlarmsTriggeredFlags();
+
+        update();
+        return flags;
+    }
+
+private:
+    T_RTC& _rtc;
+
+    uint8_t _heap[V_CAPACITY];      // alarm ids, the earliest deadline first
+    uint8_t _position[V_CAPACITY];  // heap index of each id, or c_RtcAlarmInvalid
+    uint8_t _free[V_CAPACITY];      // the unused ids, V_CAPACITY - _count of them
+    uint32_t _deadline[V_CAPACITY];
+    uint32_t _period[V_CAPACITY];
+    RtcAlarmCallback _callback[V_CAPACITY];
+    uint8_t _count;
+
+    uint32_t _programmed;
+    bool _isProgrammed;
+    bool _isDispatching;
+
+    // the callbacks take time, so the clock is read again after them and
+    // after programming, a deadline passed meanwhile would not match for a
+    // month
+    void update()
+    {
+        // a callback adding an alarm leaves it to the loop here
+        if (_isDispatching) return;
+
+        uint32_t now = _rtc.GetDateTime().TotalSeconds();
+
+        for (;;) {
+            if (!dispatch(now)) {
+                if (_count == 0 || (_isProgrammed && _programmed == _deadline[_heap[0]])) break;
+                program(_deadline[_heap[0]]);
+            }
+            now = _rtc.GetDateTime().TotalSeconds();
+        }
+    }
+
+    // false when nothing was due
+    bool dispatch(uint32_t now)
+    {
+        bool isDispatched = false;
+
+        _isDispatching = true;
+        while (_count && _deadline[_heap[0]] <= now) {
+            uint8_t id = _heap[0];
+            RtcAlarmCallback callback = _callback[id];
+
+            removeAt(0);
+            if (_period[id]) {
+                // missed periods are skipped rather than called back in a burst
+                do {
+                    _deadline[id] += _period[id];
+                } while (_deadline[id] <= now);
+                push(id);
+            }
+            else {
+                release(id);
+            }
+
+            callback(id);
+            isDispatched = true;
+        }
+        _isDispatching = false;
+
+        return isDispatched;
+    }
+
+    void program(uint32_t deadline)
+    {
+        // a deadline more than a month out fires early and is programmed again
+        _rtc.SetAlarmOne(alarmAt(RtcDateTime(deadline), &T_ALARM_ONE::ControlFlags));
+
+        _programmed = deadline;
+        _isProgrammed = true;
+    }
+
+    // the control enum is taken from the alarm class, 0x00 is
+    // HoursMinutesSecondsDayOfMonthMatch for both chips
+    template<typename T_CONTROL> static T_ALARM_ONE alarmAt(const RtcDateTime& dt, T_CONTROL (T_ALARM_ONE::*)() const)
+    {
+        return T_ALARM_ONE(dt.Day(), dt.Hour(), dt.Minute(), dt.Second(), static_cast<T_CONTROL>(0x00));
+    }
+
+    void push(uint8_t id)
+    {
+        _heap[_count] = id;
+        _position[id] = _count;
+        _count++;
+        siftUp(_count - 1);
+    }
+
+    void removeAt(uint8_t index)
+    {
+        uint8_t id = _heap[index];
+
+        _count--;
+        _position[id] = c_RtcAlarmInvalid;
+        if (index == _count) return;
+
+        // the last one fills the hole and moves whichever way it belongs
+        uint8_t moved = _heap[_count];
+
+        place(index, moved);
+        siftUp(index);
+        siftDown(_position[moved]);
+    }
+
+    // after it has left the heap
+    void release(uint8_t id)
+    {
+        _free[V_CAPACITY - 1 - _count] = id;
+    }
+
+    void place(uint8_t index, uint8_t id)
+    {
+        _heap[index] = id;
+        _position[id] = index;
+    }
+
+    void siftUp(uint8_t index)
+    {
+        uint8_t id = _heap[index];
+
+        while (index > 0) {
+            uint8_t parent = (index - 1) / 2;
+
+            if (_deadline[_heap[parent]] <= _deadline[id]) break;
+            place(index, _heap[parent]);
+            index = parent;
+        }
+        place(index, id);
+    }
+
+    void siftDown(uint8_t index)
+    {
+        uint8_t id = _heap[index];
+
+        for (;;) {
+            uint16_t child = 2 * index + 1;
+
+            if (child >= _count) break;
+            if (child + 1 < _count && _deadline[_heap[child + 1]] < _deadline[_heap[child]]) {
+                child++;
+            }
+            if (_deadline[id] <= _deadline[_heap[child]]) break;
+            place(index, _heap[child]);
+            index = child;
+        }
+        place(index, id);
+    }
+};
+
+#endif // __RTCALARMSCHEDULER_H__
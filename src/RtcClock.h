@@ -0,0 +1,228 @@
+#ifndef __RTCCLOCK_H__
+#define __RTCCLOCK_H__
+
+#include <Arduino.h>
+
+#include "RtcDateTime.h"
+
+// the RTC second always changes within this while aligning to it
+const uint16_t c_RtcClockAlignTimeoutMs = 1100;
+// beyond this the software clock is set from the RTC rather than corrected
+const int32_t c_RtcClockMaxCorrectionSeconds = 2000;
+// the RTC is read this often while aligning, rather than keeping the bus busy
+const uint8_t c_RtcClockAlignPollMs = 10;
+
+// A software clock over any of the RTC drivers.  The RTC is read by Begin()
+// and the time then follows millis(), so reading it has no bus traffic.
+//
+// Every resync interval the RTC is read again.  The RTC second covers a
+// whole second of software time, when the software time is outside of it by
+// more than the allowed drift it is moved to the edge of it.  A software
+// clock that is ahead is held rather than moved back, the time it last
+// read is kept until the corrected time catches up, so it never goes
+// backwards between resyncs.  An RTC that was set is still taken as is.
+//
+// A read of the RTC that fails, by LastError() or by reading as 0 as the
+// drivers return then, is not taken as the RTC having been set.  The time
+// is kept and the resync is tried again with the next NowSeconds().
+//
+// RtcClock<RtcDS3231<TwoWire>> Clock(Rtc, 600000); // check every 10 minutes
+template<typename T_RTC> class RtcClock
+{
+public:
+    RtcClock(T_RTC& rtc, uint32_t resyncIntervalMs = 3600000, uint16_t maxDriftMs = 0) :
+        _rtc(rtc),
+        _resyncIntervalMs(resyncIntervalMs),
+        _maxDriftMs(maxDriftMs),
+        _seconds(0),
+        _secondStartMillis(0),
+        _resyncMillis(0),
+        _lastCorrection(0),
+        _heldSeconds(0),
+        _heldMilliseconds(0),
+        _isHeld(false)
+    {
+    }
+
+    // sets the time from the RTC, aligning waits up to a second for the RTC
+    // second to change so the start of it is known, otherwise the RTC time
+    // is taken as the middle of its second.  Aligning blocks, reading the
+    // RTC every c_RtcClockAlignPollMs.  False when the RTC could not be
+    // read, the time is then left as it was.
+    bool Begin(bool isAligned = true)
+    {
+        return Sync(isAligned);
+    }
+
+    bool Sync(bool isAligned = true)
+    {
+        uint32_t seconds;
+
+        if (!readRtc(&seconds)) return false;
+
+        uint32_t start = millis();
+        uint32_t readMillis = start;
+        uint16_t offset = 500;
+
+        while (isAligned && millis() - start < c_RtcClockAlignTimeoutMs) {
+            uint32_t next;
+
+            delay(c_RtcClockAlignPollMs);
+            uint32_t nextMillis = millis();
+
+            // the edge is still after the last read that succeeded
+            if (!readRtc(&next)) continue;
+
+            if (next != seconds) {
+                // the second changed between the two reads
+                seconds = next;
+                offset = (nextMillis - readMillis) / 2;
+                break;
+            }
+            readMillis = nextMillis;
+        }
+
+        uint32_t now = millis();
+
+        _seconds = seconds;
+        _secondStartMillis = now - offset;
+        _resyncMillis = now;
+        _lastCorrection = 0;
+        _isHeld = false;
+        return true;
+    }
+
+    // seconds since 2000, the same as RtcDateTime::TotalSeconds(), and
+    // optionally the milliseconds into that second
+    uint32_t NowSeconds(uint16_t* pMilliseconds = NULL)
+    {
+        uint32_t now = millis();
+
+        if (now - _resyncMillis >= _resyncIntervalMs) {
+            resync(now);
+        }
+        advance(now);
+
+        uint32_t seconds = _seconds;
+        uint16_t milliseconds = now - _secondStartMillis;
+
+        if (_isHeld) {
+            if (isBefore(seconds, milliseconds, _heldSeconds, _heldMilliseconds)) {
+                seconds = _heldSeconds;
+                milliseconds = _heldMilliseconds;
+            }
+            else {
+                _isHeld = false;
+            }
+        }
+
+        if (pMilliseconds) {
+            *pMilliseconds = milliseconds;
+        }
+        return seconds;
+    }
+
+    RtcDateTime Now()
+    {
+        return RtcDateTime(NowSeconds());
+    }
+
+    // the milliseconds the last resync moved the time by
+    int32_t LastCorrection() const
+    {
+        return _lastCorrection;
+    }
+
+private:
+    T_RTC& _rtc;
+    const uint32_t _resyncIntervalMs;
+    const uint16_t _maxDriftMs;
+
+    uint32_t _seconds;
+    uint32_t _secondStartMillis; // millis() at the start of _seconds
+    uint32_t _resyncMillis;
+    int32_t _lastCorrection;
+
+    // the time read before a correction backwards, returned until the
+    // corrected time passes it
+    uint32_t _heldSeconds;
+    uint16_t _heldMilliseconds;
+    bool _isHeld;
+
+    static bool isBefore(uint32_t seconds, uint16_t milliseconds, uint32_t otherSeconds, uint16_t otherMilliseconds)
+    {
+        return (seconds < otherSeconds || (seconds == otherSeconds && milliseconds < otherMilliseconds));
+    }
+
+    void advance(uint32_t now)
+    {
+        uint32_t elapsed = now - _secondStartMillis;
+
+        if (elapsed >= 1000) {
+            // no division for the common case of a single second
+            uint32_t seconds = (elapsed < 2000) ? 1 : elapsed / 1000;
+
+            _seconds += seconds;
+            _secondStartMillis += seconds * 1000;
+        }
+    }
+
+    // a failed read of the RTC returns 0 from the drivers
+    bool readRtc(uint32_t* pSeconds)
+    {
+        uint32_t seconds = _rtc.GetDateTime().TotalSeconds();
+
+        if (_rtc.LastError() || seconds == 0) return false;
+
+        *pSeconds = seconds;
+        return true;
+    }
+
+    void resync(uint32_t now)
+    {
+        uint32_t rtcSeconds;
+
+        // _resyncMillis is left, so the next NowSeconds() tries again
+        if (!readRtc(&rtcSeconds)) return;
+
+        advance(now);
+        _resyncMillis = now;
+
+        int32_t difference = _seconds - rtcSeconds;
+
+        if (difference > c_RtcClockMaxCorrectionSeconds || difference < -c_RtcClockMaxCorrectionSeconds) {
+            // not drift, the RTC was set
+            _lastCorrection = static_cast<int32_t>(rtcSeconds - _seconds) * 1000;
+            _seconds = rtcSeconds;
+            _secondStartMillis = now - 500;
+            _isHeld = false;
+            return;
+        }
+
+        // from the start of the RTC second, so [0, 1000) agrees with it
+        int32_t error = difference * 1000 + static_cast<int32_t>(now - _secondStartMillis);
+
+        _lastCorrection = 0;
+        if (error < -static_cast<int32_t>(_maxDriftMs)) {
+            _lastCorrection = -error;
+            _seconds = rtcSeconds;
+            _secondStartMillis = now;
+        }
+        else if (error >= 1000 + static_cast<int32_t>(_maxDriftMs)) {
+            uint16_t milliseconds = now - _secondStartMillis;
+
+            // a hold still in place is later than the time now
+            if (!_isHeld || isBefore(_heldSeconds, _heldMilliseconds, _seconds, milliseconds)) {
+                _heldSeconds = _seconds;
+                _heldMilliseconds = milliseconds;
+                _isHeld = true;
+            }
+
+            _lastCorrection = 999 - error;
+            _seconds = rtcSeconds;
+            _secondStartMillis = now - 999;
+        }
+    }
+};
+
+#endif // __RTCCLOCK_H__
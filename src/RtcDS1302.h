@@ -4,11 +4,13 @@
 #include <Arduino.h>
 
 #include "RtcDateTime.h"
+#include "RtcTimestamp.h"
 #include "RtcUtility.h"
 
 //DS1302 Register Addresses
 const uint8_t DS1302_REG_TIMEDATE       = 0x80;
 const uint8_t DS1302_REG_TIMEDATE_BURST = 0xbe;
+const uint8_t DS1302_REG_TIMEDATE_BURST_SIZE = 8; // time date and write protect
 const uint8_t DS1302_REG_TCR            = 0x90;
 const uint8_t DS1302_REG_RAM_BURST      = 0xfe;
 const uint8_t DS1302_REG_RAMSTART       = 0xc0;
@@ -52,6 +54,9 @@ const uint8_t DS1302_CH     = 7;
 const uint8_t DS1302_REG_WP = 0x8e;
 const uint8_t DS1302_WP     = 7;
 
+// T_WIRE_METHOD is ThreeWire, ThreeWireDirect or a class of the same shape.
+// The clock and RAM bursts use its readBytes() and writeBytes() when it has
+// them, a class with only read() and write() bursts a byte at a time.
 template<typename T_WIRE_METHOD> class RtcDS1302
 {
 public:
@@ -71,6 +76,13 @@ public:
         _wire.begin(sda, scl);
     }
 
+    // the three wire bus reports no errors, this is always 0 and is here so
+    // the DS1302 can be used where the other drivers are
+    uint8_t LastError()
+    {
+        return 0;
+    }
+
     bool GetIsWriteProtected()
     {
         uint8_t wp = getReg(DS1302_REG_WP);
@@ -81,7 +93,7 @@ public:
     {
 
         uint8_t wp = getReg(DS1302_REG_WP);
-        uint8_t mask = _BV(DS1302_WP)
+        uint8_t mask = _BV(DS1302_WP);
         if (isWriteProtected) wp |= mask;
         else                  wp &= ~mask;
         setReg(DS1302_REG_WP, wp);
@@ -101,7 +113,7 @@ public:
     void SetIsRunning(bool isRunning)
     {
         uint8_t ch = getReg(DS1302_REG_CH);
-        uint8_t mask = _BV(DS1302_CH)
+        uint8_t mask = _BV(DS1302_CH);
         if (isRunning) ch &= ~mask;
         else           ch |= mask;
         setReg(DS1302_REG_CH, ch);
@@ -130,43 +142,52 @@ public:
 
     void SetDateTime(const RtcDateTime& dt)
     {
-        // set the date time
-        _wire.beginTransmission(DS1302_REG_TIMEDATE_BURST);
+        uint8_t regs[DS1302_REG_TIMEDATE_BURST_SIZE];
 
-        _wire.write(Uint8ToBcd(dt.Second()));
-        _wire.write(Uint8ToBcd(dt.Minute()));
-        _wire.write(Uint8ToBcd(dt.Hour())); // 24 hour mode only
-        _wire.write(Uint8ToBcd(dt.Day()));
-        _wire.write(Uint8ToBcd(dt.Month()));
+        // set the date time
+        encodeDateTime(dt, regs);
+        setDateTimeRegs(regs);
+    }
 
-        // RTC Hardware Day of Week is 1-7, 1 = Monday
-        // convert our Day of Week to Rtc Day of Week
-        uint8_t rtcDow = RtcDateTime::ConvertDowToRtc(dt.DayOfWeek());
-        _wire.write(Uint8ToBcd(rtcDow));
+    // Sets the time at the start of a whole second of a reference time that
+    // was taken at micros() referenceMicros.  Writing the seconds restarts
+    // the RTC second, the write starts early by the part of latencyMicros
+    // before the seconds are on the bus, so pass the result of an earlier
+    // call.  Waits up to a second and returns the microseconds the write took.
+    uint32_t SetDateTimeAtBoundary(const RtcTimestamp& reference, uint32_t referenceMicros, uint32_t latencyMicros = 0)
+    {
+        uint8_t regs[DS1302_REG_TIMEDATE_BURST_SIZE];
+        uint32_t startMicros;
 
-        _wire.write(Uint8ToBcd(dt.Year() - 2000));
-        _wire.write(0); // no write protect, as all of this is ignored if it is protected
+        // the seconds are the second of the nine bytes of the write
+        uint32_t seconds = RtcNextBoundary(reference, referenceMicros, latencyMicros * 2 / 9, &startMicros);
+        encodeDateTime(RtcDateTime(seconds), regs);
 
-        _wire.endTransmission();
+        RtcWaitForMicros(startMicros);
+        uint32_t start = micros();
+        setDateTimeRegs(regs);
+        return micros() - start;
     }
 
     RtcDateTime GetDateTime()
     {
+        uint8_t regs[DS1302_REG_TIMEDATE_BURST_SIZE];
+
         _wire.beginTransmission(DS1302_REG_TIMEDATE_BURST | THREEWIRE_READFLAG);
+        readBurst(_wire, regs, DS1302_REG_TIMEDATE_BURST_SIZE, 0);
+        _wire.endTransmission();
 
-        uint8_t second = BcdToUint8(_wire.read() & 0x7f);
-        uint8_t minute = BcdToUint8(_wire.read());
-        uint8_t hour = BcdToBin24Hour(_wire.read());
-        uint8_t dayOfMonth = BcdToUint8(_wire.read());
-        uint8_t month = BcdToUint8(_wire.read());
+        uint8_t second = BcdToUint8(regs[0] & 0x7f);
+        uint8_t minute = BcdToUint8(regs[1]);
+        uint8_t hour = BcdToBin24Hour(regs[2]);
+        uint8_t dayOfMonth = BcdToUint8(regs[3]);
+        uint8_t month = BcdToUint8(regs[4]);
 
-        _wire.read();  // throwing away day of week as we calculate it
+        // regs[5] is the day of week, throwing it away as we calculate it
 
-        uint16_t year = BcdToUint8(_wire.read()) + 2000;
+        uint16_t year = BcdToUint8(regs[6]) + 2000;
 
-        _wire.read();  // throwing away write protect flag
-
-        _wire.endTransmission();
+        // regs[7] is the write protect flag, throwing it away
 
         return RtcDateTime(year, month, dayOfMonth, hour, minute, second);
     }
@@ -199,9 +220,7 @@ public:
         uint8_t countWritten = countBytes;
 
         _wire.beginTransmission(DS1302_REG_RAM_BURST);
-
-        while (countBytes--) _wire.write(*pValue++);
-
+        writeBurst(_wire, pValue, countBytes, 0);
         _wire.endTransmission();
 
         return countWritten;
@@ -215,14 +234,40 @@ public:
         uint8_t countRead = countBytes;
 
         _wire.beginTransmission(DS1302_REG_RAM_BURST | THREEWIRE_READFLAG);
-
-        while (countBytes--) *pValue++ = _wire.read();
-
+        readBurst(_wire, pValue, countBytes, 0);
         _wire.endTransmission();
 
         return countRead;
     }
 
+    // the RAM burst always starts at the first byte, so the addressed writes
+    // are a register write per byte and the reads burst up to the last byte
+    uint8_t SetMemory(uint8_t memoryAddress, const uint8_t* pValue, uint8_t countBytes)
+    {
+        if (memoryAddress >= DS1302RamSize) return 0;
+        if (memoryAddress + countBytes > DS1302RamSize)
+            countBytes = DS1302RamSize - memoryAddress;
+
+        for (uint8_t index = 0; index < countBytes; index++)
+            setReg(DS1302_REG_RAMSTART + (memoryAddress + index) * 2, pValue[index]);
+
+        return countBytes;
+    }
+
+    uint8_t GetMemory(uint8_t memoryAddress, uint8_t* pValue, uint8_t countBytes)
+    {
+        if (memoryAddress >= DS1302RamSize) return 0;
+        if (memoryAddress + countBytes > DS1302RamSize)
+            countBytes = DS1302RamSize - memoryAddress;
+
+        uint8_t ram[DS1302RamSize];
+
+        GetMemory(ram, memoryAddress + countBytes);
+        memcpy(pValue, ram + memoryAddress, countBytes);
+
+        return countBytes;
+    }
+
 private:
     T_WIRE_METHOD& _wire;
 
@@ -240,6 +285,55 @@ private:
         _wire.write(regValue);
         _wire.endTransmission();
     }
+
+    // the int overloads are chosen when the wire class has the burst
+    // methods, otherwise they drop out and the long overloads loop
+    template<typename T> static auto readBurst(T& wire, uint8_t* pValues, uint8_t countBytes, int)
+        -> decltype(wire.readBytes(pValues, countBytes), void())
+    {
+        wire.readBytes(pValues, countBytes);
+    }
+
+    template<typename T> static void readBurst(T& wire, uint8_t* pValues, uint8_t countBytes, long)
+    {
+        while (countBytes--)
+            *pValues++ = wire.read();
+    }
+
+    template<typename T> static auto writeBurst(T& wire, const uint8_t* pValues, uint8_t countBytes, int)
+        -> decltype(wire.writeBytes(pValues, countBytes), void())
+    {
+        wire.writeBytes(pValues, countBytes);
+    }
+
+    template<typename T> static void writeBurst(T& wire, const uint8_t* pValues, uint8_t countBytes, long)
+    {
+        while (countBytes--)
+            wire.write(*pValues++);
+    }
+
+    void setDateTimeRegs(const uint8_t* regs)
+    {
+        _wire.beginTransmission(DS1302_REG_TIMEDATE_BURST);
+        writeBurst(_wire, regs, DS1302_REG_TIMEDATE_BURST_SIZE, 0);
+        _wire.endTransmission();
+    }
+
+    static void encodeDateTime(const RtcDateTime& dt, uint8_t* regs)
+    {
+        regs[0] = Uint8ToBcd(dt.Second());
+        regs[1] = Uint8ToBcd(dt.Minute());
+        regs[2] = Uint8ToBcd(dt.Hour()); // 24 hour mode only
+        regs[3] = Uint8ToBcd(dt.Day());
+        regs[4] = Uint8ToBcd(dt.Month());
+
+        // RTC Hardware Day of Week is 1-7, 1 = Monday
+        // convert our Day of Week to Rtc Day of Week
+        regs[5] = Uint8ToBcd(RtcDateTime::ConvertDowToRtc(dt.DayOfWeek()));
+
+        regs[6] = Uint8ToBcd(dt.Year() - 2000);
+        regs[7] = 0; // no write protect, as all of this is ignored if it is protected
+    }
 };
 
 #endif // __RTCDS1302_H__
@@ -4,7 +4,9 @@
 #include <Arduino.h>
 
 #include "RtcDateTime.h"
+#include "RtcTimestamp.h"
 #include "RtcUtility.h"
+#include "RtcWireSplitRead.h"
 
 //I2C Slave Address  
 const uint8_t DS1307_ADDRESS = 0x68;
@@ -85,37 +87,52 @@ public:
 
     void SetDateTime(const RtcDateTime& dt)
     {
+        uint8_t regs[DS1307_REG_TIMEDATE_SIZE];
+
         // retain running state
         uint8_t sreg = getReg(DS1307_REG_STATUS) & _BV(DS1307_CH);
         // handle _lastError?
 
         // set the date time
-        _wire.beginTransmission(DS1307_ADDRESS);
-        _wire.write(DS1307_REG_TIMEDATE);
+        encodeDateTime(dt, regs);
+        regs[0] |= sreg;
+        setDateTimeRegs(regs);
+    }
 
-        _wire.write(Uint8ToBcd(dt.Second()) | sreg);
-        _wire.write(Uint8ToBcd(dt.Minute()));
-        _wire.write(Uint8ToBcd(dt.Hour())); // 24 hour mode only
+    // Sets the time at the start of a whole second of a reference time that
+    // was taken at micros() referenceMicros.  Writing the seconds restarts
+    // the RTC second, the write starts early by the part of latencyMicros
+    // before the seconds are on the bus, so pass the result of an earlier
+    // call.  Waits up to a second and returns the microseconds the write took.
+    uint32_t SetDateTimeAtBoundary(const RtcTimestamp& reference, uint32_t referenceMicros, uint32_t latencyMicros = 0)
+    {
+        uint8_t regs[DS1307_REG_TIMEDATE_SIZE];
+        uint32_t startMicros;
 
-        // RTC Hardware Day of Week is 1-7, 1 = Monday
-        // convert our Day of Week to Rtc Day of Week
-        uint8_t rtcDow = RtcDateTime::ConvertDowToRtc(dt.DayOfWeek());
+        // retain running state
+        uint8_t sreg = getReg(DS1307_REG_STATUS) & _BV(DS1307_CH);
+        if (_lastError) return 0;
 
-        _wire.write(Uint8ToBcd(rtcDow)); 
-        _wire.write(Uint8ToBcd(dt.Day()));
-        _wire.write(Uint8ToBcd(dt.Month()));
-        _wire.write(Uint8ToBcd(dt.Year() - 2000));
+        // the seconds are the third of the nine bytes of the write
+        uint32_t seconds = RtcNextBoundary(reference, referenceMicros, latencyMicros / 3, &startMicros);
+        encodeDateTime(RtcDateTime(seconds), regs);
+        regs[0] |= sreg;
 
-        _lastError = _wire.endTransmission();
+        RtcWaitForMicros(startMicros);
+        uint32_t start = micros();
+        setDateTimeRegs(regs);
+        return micros() - start;
     }
 
     RtcDateTime GetDateTime()
     {
+        uint8_t regs[DS1307_REG_TIMEDATE_SIZE];
+
         _wire.beginTransmission(DS1307_ADDRESS);
         _wire.write(DS1307_REG_TIMEDATE);
 
         _lastError = _wire.endTransmission();
-        if (_lastError) RtcDateTime(0);
+        if (_lastError) return RtcDateTime(0);
 
         uint8_t bytesRead = _wire.requestFrom(DS1307_ADDRESS, DS1307_REG_TIMEDATE_SIZE);
         if (bytesRead != DS1307_REG_TIMEDATE_SIZE) {
@@ -123,17 +140,47 @@ public:
             return RtcDateTime(0);
         }
 
-        uint8_t second = BcdToUint8(_wire.read() & 0x7f);
-        uint8_t minute = BcdToUint8(_wire.read());
-        uint8_t hour = BcdToBin24Hour(_wire.read());
+        for (uint8_t index = 0; index < DS1307_REG_TIMEDATE_SIZE; index++)
+            regs[index] = _wire.read();
 
-        _wire.read();  // throwing away day of week as we calculate it
+        return decodeDateTime(regs);
+    }
 
-        uint8_t dayOfMonth = BcdToUint8(_wire.read());
-        uint8_t month = BcdToUint8(_wire.read());
-        uint16_t year = BcdToUint8(_wire.read()) + 2000;
+    // the state of a split phase GetDateTime, kept by the caller so that
+    // only a sketch using it pays for the buffer
+    typedef RtcWireSplitRead<T_WIRE_METHOD, DS1307_REG_TIMEDATE_SIZE> SplitDateTime;
+
+    // Split phase GetDateTime, the read moves on a bus phase with each call
+    // to ProcessGetDateTime() and the caller can do other work between them.
+    // Other methods must not be called while the read is Busy.  It is not a
+    // non blocking read, with the stock Wire library requestFrom() blocks
+    // and the first Process waits out the read phase, see RtcWireSplitRead.
+    //
+    //   RtcDS1307<TwoWire>::SplitDateTime splitNow(Wire);
+    //   rtc.StartGetDateTime(splitNow);
+    //   ...
+    //   if (rtc.ProcessGetDateTime(splitNow) == RtcAsyncState_Complete)
+    //       now = rtc.CompleteGetDateTime(splitNow);
+    bool StartGetDateTime(SplitDateTime& read)
+    {
+        bool isStarted = read.Start(DS1307_ADDRESS, DS1307_REG_TIMEDATE);
+        _lastError = read.LastError();
+        return isStarted;
+    }
 
-        return RtcDateTime(year, month, dayOfMonth, hour, minute, second);
+    RtcAsyncState ProcessGetDateTime(SplitDateTime& read)
+    {
+        RtcAsyncState state = read.Process();
+        _lastError = read.LastError();
+        return state;
+    }
+
+    RtcDateTime CompleteGetDateTime(SplitDateTime& read)
+    {
+        if (read.State() != RtcAsyncState_Complete)
+            return RtcDateTime(0);
+
+        return decodeDateTime(read.Complete());
     }
 
     void SetMemory(uint8_t memoryAddress, uint8_t value)
@@ -156,8 +203,8 @@ public:
         uint8_t address = memoryAddress + DS1307_REG_RAMSTART;
 
         if (address > DS1307_REG_RAMEND) return 0;
-        if (address + countBytes > DS1307_REG_RAMEND)
-            countBytes = DS1307_REG_RAMEND - address;
+        if (address + countBytes > DS1307_REG_RAMEND + 1)
+            countBytes = DS1307_REG_RAMEND + 1 - address;
 
         uint8_t countWritten = countBytes;
 
@@ -176,8 +223,8 @@ public:
     {
         uint8_t address = memoryAddress + DS1307_REG_RAMSTART;
         if (address > DS1307_REG_RAMEND) return 0;
-        if (countBytes > DS1307_REG_RAMSIZE)
-            countBytes = DS1307_REG_RAMSIZE;
+        if (address + countBytes > DS1307_REG_RAMEND + 1)
+            countBytes = DS1307_REG_RAMEND + 1 - address;
 
         _wire.beginTransmission(DS1307_ADDRESS);
         _wire.write(address);
@@ -228,6 +275,45 @@ private:
         _lastError = _wire.endTransmission();
         // handle _lastError?
     }
+
+    void setDateTimeRegs(const uint8_t* regs)
+    {
+        _wire.beginTransmission(DS1307_ADDRESS);
+        _wire.write(DS1307_REG_TIMEDATE);
+        for (uint8_t index = 0; index < DS1307_REG_TIMEDATE_SIZE; index++)
+            _wire.write(regs[index]);
+        _lastError = _wire.endTransmission();
+    }
+
+    static void encodeDateTime(const RtcDateTime& dt, uint8_t* regs)
+    {
+        regs[0] = Uint8ToBcd(dt.Second());
+        regs[1] = Uint8ToBcd(dt.Minute());
+        regs[2] = Uint8ToBcd(dt.Hour()); // 24 hour mode only
+
+        // RTC Hardware Day of Week is 1-7, 1 = Monday
+        // convert our Day of Week to Rtc Day of Week
+        regs[3] = Uint8ToBcd(RtcDateTime::ConvertDowToRtc(dt.DayOfWeek()));
+
+        regs[4] = Uint8ToBcd(dt.Day());
+        regs[5] = Uint8ToBcd(dt.Month());
+        regs[6] = Uint8ToBcd(dt.Year() - 2000);
+    }
+
+    static RtcDateTime decodeDateTime(const uint8_t* regs)
+    {
+        uint8_t second = BcdToUint8(regs[0] & 0x7f);
+        uint8_t minute = BcdToUint8(regs[1]);
+        uint8_t hour = BcdToBin24Hour(regs[2]);
+
+        // regs[3] is the day of week, throwing it away as we calculate it
+
+        uint8_t dayOfMonth = BcdToUint8(regs[4]);
+        uint8_t month = BcdToUint8(regs[5]);
+        uint16_t year = BcdToUint8(regs[6]) + 2000;
+
+        return RtcDateTime(year, month, dayOfMonth, hour, minute, second);
+    }
 };
 
 #endif // __RTCDS1307_H__
@@ -4,8 +4,11 @@
 #include <Arduino.h>
 
 #include "RtcDateTime.h"
+#include "RtcDS323xCommon.h"
 #include "RtcTemperature.h"
+#include "RtcTimestamp.h"
 #include "RtcUtility.h"
+#include "RtcWireSplitRead.h"
 
 //I2C Slave Address  
 const uint8_t DS3231_ADDRESS = 0x68;
@@ -27,6 +30,8 @@ const uint8_t DS3231_REG_ALARMONE_SIZE = 4;
 const uint8_t DS3231_REG_ALARMTWO_SIZE = 3;
 
 const uint8_t DS3231_REG_TEMP_SIZE = 2;
+const uint8_t DS3231_REG_CONTROL_TO_AGING_SIZE = 3;
+const uint8_t DS3231_REG_SNAPSHOT_SIZE = 0x13; // time date through temperature
 
 // DS3231 Control Register Bits
 const uint8_t DS3231_A1IE  = 0;
@@ -47,8 +52,16 @@ const uint8_t DS3231_BSY      = 2;
 const uint8_t DS3231_EN32KHZ  = 3;
 const uint8_t DS3231_OSF      = 7;
 const uint8_t DS3231_AIFMASK = (_BV(DS3231_A1F) | _BV(DS3231_A2F));
+// flags only the hardware sets, writing a 0 clears them and writing a 1 has no effect
+const uint8_t DS3231_FLAGMASK = (_BV(DS3231_OSF) | DS3231_AIFMASK);
 
 
+// a temperature conversion takes about 125ms and up to 200ms, so polling
+// every 10ms costs only a few bus transactions.  The timeout allows for an
+// automatic conversion that has to finish before the forced one starts
+const uint16_t c_Ds3231ConversionPollMs = 10;
+const uint16_t c_Ds3231ConversionTimeoutMs = 400;
+
 // seconds accuracy
 enum DS3231AlarmOneControl {
     // bit order:  A1M4  DY/DT  A1M3  A1M2  A1M1
@@ -212,12 +225,24 @@ enum DS3231AlarmFlag {
     DS3231AlarmFlag_AlarmBoth = 0x03,
 };
 
+// every register from time date through temperature, decoded from one burst read
+typedef RtcDS323xSnapshot<DS3231AlarmOne, DS3231AlarmTwo, DS3231AlarmFlag> DS3231Snapshot;
+
 template<typename T_WIRE_METHOD> class RtcDS3231
 {
 public:
     RtcDS3231(T_WIRE_METHOD& wire) :
         _wire(wire),
-        _lastError(0)
+        _lastError(0),
+        _isCacheEnabled(false),
+        _isCacheValid(false),
+        _controlCache(0),
+        _statusCache(0),
+        _agingCache(0),
+        _conversionState(RtcAsyncState_Idle),
+        _isConversionForced(false),
+        _conversionStartMillis(0),
+        _conversionPollMillis(0)
     {
     }
 
@@ -236,101 +261,141 @@ public:
         return _lastError;
     }
 
+    // The register cache keeps a copy of the control, status and aging
+    // registers so that configuration changes only need to write them, halving
+    // the bus traffic of the read-modify-write calls.  The status flags the
+    // hardware owns (OSF, A1F, A2F and BSY) are never served from the cache.
+    // Only enable it when nothing else writes these registers, or call
+    // InvalidateRegisterCache() after something else may have.
+    void EnableRegisterCache(bool enable)
+    {
+        _isCacheEnabled = enable;
+        _isCacheValid = false;
+    }
+
+    void InvalidateRegisterCache()
+    {
+        _isCacheValid = false;
+    }
+
+    void RefreshRegisterCache()
+    {
+        uint8_t regs[DS3231_REG_CONTROL_TO_AGING_SIZE];
+
+        _isCacheValid = false;
+        if (!getRegs(DS3231_REG_CONTROL, regs, DS3231_REG_CONTROL_TO_AGING_SIZE)) return;
+
+        updateRegisterCache(regs);
+    }
+
     bool IsDateTimeValid()
     {
+        // OSF is set by the hardware, so always read
         uint8_t status = getReg(DS3231_REG_STATUS);
+        if (!_lastError) updateStatusCache(status);
         return !(status & _BV(DS3231_OSF)) && !_lastError;
     }
 
     bool GetIsRunning()
     {
-        uint8_t creg = getReg(DS3231_REG_CONTROL);
+        uint8_t creg = getControl();
         return !(creg & _BV(DS3231_EOSC)) && !_lastError;
     }
 
     void SetIsRunning(bool isRunning)
     {
-        uint8_t creg = getReg(DS3231_REG_CONTROL);
+        uint8_t creg = getControl();
         if (isRunning) creg &= ~_BV(DS3231_EOSC);
         else           creg |= _BV(DS3231_EOSC);
-        setReg(DS3231_REG_CONTROL, creg);
+        setControl(creg);
     }
 
     void SetDateTime(const RtcDateTime& dt)
     {
+        uint8_t regs[DS3231_REG_TIMEDATE_SIZE];
+
         // clear the invalid flag
-        uint8_t status = getReg(DS3231_REG_STATUS);
-        status &= ~_BV(DS3231_OSF); // clear the flag
-        setReg(DS3231_REG_STATUS, status);
+        setStatus(getStatus(), _BV(DS3231_OSF));
 
         // set the date time
-        _wire.beginTransmission(DS3231_ADDRESS);
-        _wire.write(DS3231_REG_TIMEDATE);
-
-        _wire.write(Uint8ToBcd(dt.Second()));
-        _wire.write(Uint8ToBcd(dt.Minute()));
-        _wire.write(Uint8ToBcd(dt.Hour())); // 24 hour mode only
-
-        uint8_t year = dt.Year() - 2000;
-        uint8_t centuryFlag = 0;
-
-        if (year >= 100) {
-            year -= 100;
-            centuryFlag = _BV(7);
-        }
+        Ds323xEncodeDateTime(dt, regs);
+        setDateTimeRegs(regs);
+    }
 
-        // RTC Hardware Day of Week is 1-7, 1 = Monday
-        // convert our Day of Week to Rtc Day of Week
-        uint8_t rtcDow = RtcDateTime::ConvertDowToRtc(dt.DayOfWeek());
+    // Sets the time at the start of a whole second of a reference time that
+    // was taken at micros() referenceMicros.  Writing the seconds restarts
+    // the RTC second, the write starts early by the part of latencyMicros
+    // before the seconds are on the bus, so pass the result of an earlier
+    // call.  Waits up to a second and returns the microseconds the write took.
+    uint32_t SetDateTimeAtBoundary(const RtcTimestamp& reference, uint32_t referenceMicros, uint32_t latencyMicros = 0)
+    {
+        uint8_t regs[DS3231_REG_TIMEDATE_SIZE];
+        uint32_t startMicros;
 
-        _wire.write(Uint8ToBcd(rtcDow));
+        // clear the invalid flag
+        setStatus(getStatus(), _BV(DS3231_OSF));
+        if (_lastError) return 0;
 
-        _wire.write(Uint8ToBcd(dt.Day()));
-        _wire.write(Uint8ToBcd(dt.Month()) | centuryFlag);
-        _wire.write(Uint8ToBcd(year));
+        // the seconds are the third of the nine bytes of the write
+        uint32_t seconds = RtcNextBoundary(reference, referenceMicros, latencyMicros / 3, &startMicros);
+        Ds323xEncodeDateTime(RtcDateTime(seconds), regs);
 
-        _lastError = _wire.endTransmission();
+        RtcWaitForMicros(startMicros);
+        uint32_t start = micros();
+        setDateTimeRegs(regs);
+        return micros() - start;
     }
 
     RtcDateTime GetDateTime()
     {
-        _wire.beginTransmission(DS3231_ADDRESS);
-        _wire.write(DS3231_REG_TIMEDATE);
+        uint8_t regs[DS3231_REG_TIMEDATE_SIZE];
 
-        _lastError = _wire.endTransmission();
-        if (_lastError) return RtcDateTime(0);
-
-        uint8_t bytesRead = _wire.requestFrom(DS3231_ADDRESS, DS3231_REG_TIMEDATE_SIZE);
-        if (bytesRead != DS3231_REG_TIMEDATE_SIZE) {
-            _lastError = 4;
+        if (!getRegs(DS3231_REG_TIMEDATE, regs, DS3231_REG_TIMEDATE_SIZE))
             return RtcDateTime(0);
-        }
 
-        uint8_t second = BcdToUint8(_wire.read() & 0x7f);
-        uint8_t minute = BcdToUint8(_wire.read());
-        uint8_t hour = BcdToBin24Hour(_wire.read());
+        return Ds323xDecodeDateTime(regs);
+    }
 
-        _wire.read();  // throwing away day of week as we calculate it
+    // the state of a split phase GetDateTime, kept by the caller so that
+    // only a sketch using it pays for the buffer
+    typedef RtcWireSplitRead<T_WIRE_METHOD, DS3231_REG_TIMEDATE_SIZE> SplitDateTime;
 
-        uint8_t dayOfMonth = BcdToUint8(_wire.read());
-        uint8_t monthRaw = _wire.read();
-        uint16_t year = BcdToUint8(_wire.read()) + 2000;
+    // Split phase GetDateTime, the read moves on a bus phase with each call
+    // to ProcessGetDateTime() and the caller can do other work between them.
+    // Other methods must not be called while the read is Busy.  It is not a
+    // non blocking read, with the stock Wire library requestFrom() blocks
+    // and the first Process waits out the read phase, see RtcWireSplitRead.
+    //
+    //   RtcDS3231<TwoWire>::SplitDateTime splitNow(Wire);
+    //   rtc.StartGetDateTime(splitNow);
+    //   ...
+    //   if (rtc.ProcessGetDateTime(splitNow) == RtcAsyncState_Complete)
+    //       now = rtc.CompleteGetDateTime(splitNow);
+    bool StartGetDateTime(SplitDateTime& read)
+    {
+        bool isStarted = read.Start(DS3231_ADDRESS, DS3231_REG_TIMEDATE);
+        _lastError = read.LastError();
+        return isStarted;
+    }
 
-        if (monthRaw & _BV(7)) // century wrap flag
-            year += 100;
-        uint8_t month = BcdToUint8(monthRaw & 0x7f);
+    RtcAsyncState ProcessGetDateTime(SplitDateTime& read)
+    {
+        RtcAsyncState state = read.Process();
+        _lastError = read.LastError();
+        return state;
+    }
 
+    RtcDateTime CompleteGetDateTime(SplitDateTime& read)
+    {
+        if (read.State() != RtcAsyncState_Complete)
+            return RtcDateTime(0);
 
-        return RtcDateTime(year, month, dayOfMonth, hour, minute, second);
+        return Ds323xDecodeDateTime(read.Complete());
     }
 
     RtcTemperature GetTemperature()
     {
-        _wire.beginTransmission(DS3231_ADDRESS);
-        _wire.write(DS3231_REG_TEMP);
-
-        _lastError = _wire.endTransmission();
-        if (_lastError) return RtcTemperature(0);
+        uint8_t regs[DS3231_REG_TEMP_SIZE];
 
         // Temperature is represented as a 10-bit code with a resolution
         // of 1/4th °C and is accessable as a signed 16-bit integer at
@@ -346,29 +411,73 @@ public:
         // For example, at +/- 25.25°C, concatenated registers <r11h:r12h> =
         // 256 * (+/- 25+(1/4)) = +/- 6464, or 1940h / E6C0h.
 
-        uint8_t bytesRead = _wire.requestFrom(DS3231_ADDRESS, DS3231_REG_TEMP_SIZE);
-        if (bytesRead != DS3231_REG_TEMP_SIZE) {
-            _lastError = 4;
+        if (!getRegs(DS3231_REG_TEMP, regs, DS3231_REG_TEMP_SIZE))
             return RtcTemperature(0);
+
+        return Ds323xDecodeTemperature(regs);
+    }
+
+    // with forceConversion the temperature is measured by a new conversion,
+    // sleeping while it completes rather than spinning on the bus
+    RtcTemperature GetTemperature(bool forceConversion)
+    {
+        if (forceConversion) {
+            if (!StartTemperatureConversion())
+                return RtcTemperature(0);
+
+            while (ProcessTemperatureConversion() == RtcAsyncState_Busy)
+                delay(c_Ds3231ConversionPollMs);
+
+            return CompleteTemperatureConversion();
         }
 
-        int8_t r11h = _wire.read();                   // MS byte, signed temperature
-        return RtcTemperature(r11h, _wire.read());    // LS byte is r12h
+        return GetTemperature();
+    }
+
+    // Reads every register from time date through temperature in one burst,
+    // replacing the separate GetDateTime, GetAlarmOne, GetAlarmTwo,
+    // IsDateTimeValid, GetAgingOffset and GetTemperature transactions.
+    // It also refreshes the register cache when that is enabled.
+    DS3231Snapshot GetSnapshot()
+    {
+        uint8_t regs[DS3231_REG_SNAPSHOT_SIZE];
+
+        if (!getRegs(DS3231_REG_TIMEDATE, regs, DS3231_REG_SNAPSHOT_SIZE)) {
+            // report the time as invalid when it could not be read
+            return DS3231Snapshot(RtcDateTime(0),
+                    DS3231AlarmOne(0, 0, 0, 0, DS3231AlarmOneControl_HoursMinutesSecondsDayOfMonthMatch),
+                    DS3231AlarmTwo(0, 0, 0, DS3231AlarmTwoControl_HoursMinutesDayOfMonthMatch),
+                    0,
+                    _BV(DS3231_OSF),
+                    0,
+                    RtcTemperature(0));
+        }
+
+        if (_isCacheEnabled)
+            updateRegisterCache(regs + DS3231_REG_CONTROL);
+
+        return DS3231Snapshot(Ds323xDecodeDateTime(regs + DS3231_REG_TIMEDATE),
+                Ds323xDecodeAlarmOne<DS3231AlarmOne>(regs + DS3231_REG_ALARMONE),
+                Ds323xDecodeAlarmTwo<DS3231AlarmTwo>(regs + DS3231_REG_ALARMTWO),
+                regs[DS3231_REG_CONTROL],
+                regs[DS3231_REG_STATUS],
+                regs[DS3231_REG_AGING],
+                Ds323xDecodeTemperature(regs + DS3231_REG_TEMP));
     }
 
     void Enable32kHzPin(bool enable)
     {
-        uint8_t sreg = getReg(DS3231_REG_STATUS);
+        uint8_t sreg = getStatus();
 
         if (enable) sreg |= _BV(DS3231_EN32KHZ);
         else        sreg &= ~_BV(DS3231_EN32KHZ);
 
-        setReg(DS3231_REG_STATUS, sreg);
+        setStatus(sreg, 0);
     }
 
     void SetSquareWavePin(DS3231SquareWavePinMode pinMode, bool enableWhileInBatteryBackup = true)
     {
-        uint8_t creg = getReg(DS3231_REG_CONTROL);
+        uint8_t creg = getControl();
 
         // clear all relevant bits to a known "off" state
         creg &= ~(DS3231_AIEMASK | _BV(DS3231_BBSQW));
@@ -387,17 +496,17 @@ public:
             if (enableWhileInBatteryBackup)
                 creg |= _BV(DS3231_BBSQW); // set enable int/sqw while in battery backup flag
         }
-        setReg(DS3231_REG_CONTROL, creg);
+        setControl(creg);
     }
 
     void SetSquareWavePinClockFrequency(DS3231SquareWaveClock freq)
     {
-        uint8_t creg = getReg(DS3231_REG_CONTROL);
+        uint8_t creg = getControl();
 
         creg &= ~DS3231_RSMASK; // Set to 0
         creg |= (freq & DS3231_RSMASK); // Set freq bits
 
-        setReg(DS3231_REG_CONTROL, creg);
+        setControl(creg);
     }
 
 
@@ -439,110 +548,224 @@ public:
 
     DS3231AlarmOne GetAlarmOne()
     {
-        _wire.beginTransmission(DS3231_ADDRESS);
-        _wire.write(DS3231_REG_ALARMONE);
+        uint8_t regs[DS3231_REG_ALARMONE_SIZE];
 
-        _lastError = _wire.endTransmission();
-        if (_lastError)
-            return DS3231AlarmOne(0, 0, 0, 0, DS3231AlarmOneControl_HoursMinutesSecondsDayOfMonthMatch);
-
-        uint8_t bytesRead = _wire.requestFrom(DS3231_ADDRESS, DS3231_REG_ALARMONE_SIZE);
-        if (bytesRead != DS3231_REG_ALARMONE_SIZE) {
-            _lastError = 4;
+        if (!getRegs(DS3231_REG_ALARMONE, regs, DS3231_REG_ALARMONE_SIZE))
             return DS3231AlarmOne(0, 0, 0, 0, DS3231AlarmOneControl_HoursMinutesSecondsDayOfMonthMatch);
-        }
-
-        uint8_t raw = _wire.read();
-        uint8_t flags = (raw & 0x80) >> 7;
-        uint8_t second = BcdToUint8(raw & 0x7f);
-
-        raw = _wire.read();
-        flags |= (raw & 0x80) >> 6;
-        uint8_t minute = BcdToUint8(raw & 0x7f);
-
-        raw = _wire.read();
-        flags |= (raw & 0x80) >> 5;
-        uint8_t hour = BcdToBin24Hour(raw & 0x7f);
-
-        raw = _wire.read();
-        flags |= (raw & 0xc0) >> 3;
-        uint8_t dayOf = BcdToUint8(raw & 0x3f);
 
-        if (flags == DS3231AlarmOneControl_HoursMinutesSecondsDayOfWeekMatch)
-            dayOf = RtcDateTime::ConvertRtcToDow(dayOf);
-
-        return DS3231AlarmOne(dayOf, hour, minute, second, (DS3231AlarmOneControl)flags);
+        return Ds323xDecodeAlarmOne<DS3231AlarmOne>(regs);
     }
 
     DS3231AlarmTwo GetAlarmTwo()
     {
-        _wire.beginTransmission(DS3231_ADDRESS);
-        _wire.write(DS3231_REG_ALARMTWO);
-
-        _lastError = _wire.endTransmission();
-        if (_lastError)
-            return DS3231AlarmTwo(0, 0, 0, DS3231AlarmTwoControl_HoursMinutesDayOfMonthMatch);
+        uint8_t regs[DS3231_REG_ALARMTWO_SIZE];
 
-        uint8_t bytesRead = _wire.requestFrom(DS3231_ADDRESS, DS3231_REG_ALARMTWO_SIZE);
-        if (bytesRead != DS3231_REG_ALARMTWO_SIZE) {
-            _lastError = 4;
+        if (!getRegs(DS3231_REG_ALARMTWO, regs, DS3231_REG_ALARMTWO_SIZE))
             return DS3231AlarmTwo(0, 0, 0, DS3231AlarmTwoControl_HoursMinutesDayOfMonthMatch);
-        }
-
-        uint8_t raw = _wire.read();
-        uint8_t flags = (raw & 0x80) >> 7;
-        uint8_t minute = BcdToUint8(raw & 0x7f);
 
-        raw = _wire.read();
-        flags |= (raw & 0x80) >> 6;
-        uint8_t hour = BcdToBin24Hour(raw & 0x7f);
-
-        raw = _wire.read();
-        flags |= (raw & 0xc0) >> 4;
-        uint8_t dayOf = BcdToUint8(raw & 0x3f);
-
-        if (flags == DS3231AlarmTwoControl_HoursMinutesDayOfWeekMatch)
-            dayOf = RtcDateTime::ConvertRtcToDow(dayOf);
-
-        return DS3231AlarmTwo(dayOf, hour, minute, (DS3231AlarmTwoControl)flags);
+        return Ds323xDecodeAlarmTwo<DS3231AlarmTwo>(regs);
     }
 
     // Latch must be called after an alarm otherwise it will not
     // trigger again
     DS3231AlarmFlag LatchAlarmsTriggeredFlags()
     {
+        // the alarm flags are set by the hardware, so always read
         uint8_t sreg = getReg(DS3231_REG_STATUS);
         uint8_t alarmFlags = (sreg & DS3231_AIFMASK);
-        sreg &= ~DS3231_AIFMASK; // clear the flags
-        setReg(DS3231_REG_STATUS, sreg);
+        setStatus(sreg, DS3231_AIFMASK); // clear the flags
         return (DS3231AlarmFlag)alarmFlags;
     }
 
     void ForceTemperatureCompensationUpdate(bool block)
     {
-        uint8_t creg = getReg(DS3231_REG_CONTROL);
-        creg |= _BV(DS3231_CONV); // Write CONV bit
-        setReg(DS3231_REG_CONTROL, creg);
+        if (!block) {
+            uint8_t creg = getControl();
+            creg |= _BV(DS3231_CONV); // Write CONV bit
+            setControl(creg);
+            return;
+        }
 
-        while (block && (creg & _BV(DS3231_CONV)))
-            // Block until CONV is 0
-            creg = getReg(DS3231_REG_CONTROL);
+        // a conversion already started by StartTemperatureConversion()
+        // updates the compensation too, wait for it and leave its result
+        // for CompleteTemperatureConversion()
+        if (_conversionState == RtcAsyncState_Busy) {
+            while (ProcessTemperatureConversion() == RtcAsyncState_Busy)
+                delay(c_Ds3231ConversionPollMs);
+            return;
+        }
+
+        // sleep between the polls rather than spinning on the bus
+        if (StartTemperatureConversion()) {
+            while (ProcessTemperatureConversion() == RtcAsyncState_Busy)
+                delay(c_Ds3231ConversionPollMs);
+        }
+        _conversionState = RtcAsyncState_Idle;
+    }
+
+    // Non blocking temperature conversion.  Start forces a conversion, or
+    // defers it while an automatic one is busy, and ProcessTemperatureConversion()
+    // checks on it no more than every c_Ds3231ConversionPollMs, so it can be
+    // called on every pass of the caller's loop.
+    //
+    //   rtc.StartTemperatureConversion();
+    //   ...
+    //   if (rtc.ProcessTemperatureConversion() == RtcAsyncState_Complete)
+    //       temperature = rtc.CompleteTemperatureConversion();
+    bool StartTemperatureConversion()
+    {
+        _conversionStartMillis = millis();
+        _conversionPollMillis = _conversionStartMillis;
+        _isConversionForced = false;
+        _conversionState = RtcAsyncState_Busy;
+
+        forceConversion();
+        return (_conversionState == RtcAsyncState_Busy);
+    }
+
+    RtcAsyncState ProcessTemperatureConversion()
+    {
+        if (_conversionState != RtcAsyncState_Busy)
+            return _conversionState;
+
+        uint32_t now = millis();
+        if (now - _conversionPollMillis < c_Ds3231ConversionPollMs)
+            return _conversionState;
+        _conversionPollMillis = now;
+
+        if (!_isConversionForced) {
+            forceConversion();
+        }
+        else {
+            // CONV is cleared by the hardware once the conversion completes
+            uint8_t creg = getReg(DS3231_REG_CONTROL);
+            if (_lastError) {
+                _conversionState = RtcAsyncState_Error;
+                return _conversionState;
+            }
+            if (!(creg & _BV(DS3231_CONV)))
+                _conversionState = RtcAsyncState_Complete;
+        }
+
+        if (_conversionState == RtcAsyncState_Busy &&
+                now - _conversionStartMillis > c_Ds3231ConversionTimeoutMs) {
+            _lastError = c_RtcWireTimeoutError;
+            _conversionState = RtcAsyncState_Error;
+        }
+
+        return _conversionState;
+    }
+
+    // the temperature measured by the conversion
+    RtcTemperature CompleteTemperatureConversion()
+    {
+        if (_conversionState != RtcAsyncState_Complete)
+            return RtcTemperature(0);
+
+        _conversionState = RtcAsyncState_Idle;
+        return GetTemperature();
     }
 
     int8_t GetAgingOffset()
     {
-        return getReg(DS3231_REG_AGING);
+        return useCache() ? _agingCache : getReg(DS3231_REG_AGING);
     }
 
     void SetAgingOffset(int8_t value)
     {
         setReg(DS3231_REG_AGING, value);
+        _agingCache = value;
+        if (_lastError) _isCacheValid = false;
     }
 
 private:
     T_WIRE_METHOD& _wire;
     uint8_t _lastError;
 
+    bool _isCacheEnabled;
+    bool _isCacheValid;
+    uint8_t _controlCache;
+    uint8_t _statusCache;  // without the hardware owned flags
+    uint8_t _agingCache;
+
+    RtcAsyncState _conversionState;
+    bool _isConversionForced;
+    uint32_t _conversionStartMillis;
+    uint32_t _conversionPollMillis;
+
+    bool useCache()
+    {
+        if (_isCacheEnabled && !_isCacheValid)
+            RefreshRegisterCache();
+        return _isCacheValid;
+    }
+
+    // regs holds the control, status and aging registers
+    void updateRegisterCache(const uint8_t* regs)
+    {
+        updateControlCache(regs[0]);
+        updateStatusCache(regs[1]);
+        _agingCache = regs[2];
+        _isCacheValid = true;
+    }
+
+    void updateControlCache(uint8_t creg)
+    {
+        // CONV is cleared by the hardware once the conversion completes
+        _controlCache = creg & ~_BV(DS3231_CONV);
+    }
+
+    void updateStatusCache(uint8_t sreg)
+    {
+        _statusCache = sreg & ~(DS3231_FLAGMASK | _BV(DS3231_BSY));
+    }
+
+    uint8_t getControl()
+    {
+        return useCache() ? _controlCache : getReg(DS3231_REG_CONTROL);
+    }
+
+    void setControl(uint8_t creg)
+    {
+        setReg(DS3231_REG_CONTROL, creg);
+        updateControlCache(creg);
+        if (_lastError) _isCacheValid = false;
+    }
+
+    // only the software owned bits are valid when served from the cache,
+    // which is all setStatus() needs
+    uint8_t getStatus()
+    {
+        return useCache() ? _statusCache : getReg(DS3231_REG_STATUS);
+    }
+
+    void setStatus(uint8_t sreg, uint8_t flagsToClear)
+    {
+        // the hardware flags are written as 1 unless being cleared, so any
+        // flag raised since sreg was read is not lost
+        sreg |= DS3231_FLAGMASK;
+        sreg &= ~flagsToClear;
+        setReg(DS3231_REG_STATUS, sreg);
+        updateStatusCache(sreg);
+        if (_lastError) _isCacheValid = false;
+    }
+
+    // CONV is ignored while BSY reports an automatic conversion, so that
+    // has to finish first
+    void forceConversion()
+    {
+        uint8_t sreg = getReg(DS3231_REG_STATUS);
+        if (!_lastError && !(sreg & _BV(DS3231_BSY))) {
+            uint8_t creg = getControl();
+            creg |= _BV(DS3231_CONV);
+            setControl(creg);
+            _isConversionForced = true;
+        }
+
+        if (_lastError)
+            _conversionState = RtcAsyncState_Error;
+    }
+
     uint8_t getReg(uint8_t regAddress)
     {
         _wire.beginTransmission(DS3231_ADDRESS);
@@ -561,6 +784,34 @@ private:
         return _wire.read();
     }
 
+    // burst read of consecutive registers, the register address auto
+    // increments so reads larger than the Wire buffer continue where
+    // the previous request stopped
+    bool getRegs(uint8_t regAddress, uint8_t* pValues, uint8_t countBytes)
+    {
+        _wire.beginTransmission(DS3231_ADDRESS);
+        _wire.write(regAddress);
+
+        _lastError = _wire.endTransmission();
+        if (_lastError) return false;
+
+        while (countBytes) {
+            uint8_t countChunk = (countBytes < RTC_WIRE_BUFFER_SIZE) ? countBytes : RTC_WIRE_BUFFER_SIZE;
+
+            uint8_t bytesRead = _wire.requestFrom(DS3231_ADDRESS, countChunk);
+            if (bytesRead != countChunk) {
+                _lastError = 4;
+                return false;
+            }
+
+            countBytes -= countChunk;
+            while (countChunk--)
+                *pValues++ = _wire.read();
+        }
+
+        return true;
+    }
+
     void setReg(uint8_t regAddress, uint8_t regValue)
     {
         _wire.beginTransmission(DS3231_ADDRESS);
@@ -569,6 +820,14 @@ private:
         _lastError = _wire.endTransmission();
     }
 
+    void setDateTimeRegs(const uint8_t* regs)
+    {
+        _wire.beginTransmission(DS3231_ADDRESS);
+        _wire.write(DS3231_REG_TIMEDATE);
+        for (uint8_t index = 0; index < DS3231_REG_TIMEDATE_SIZE; index++)
+            _wire.write(regs[index]);
+        _lastError = _wire.endTransmission();
+    }
 };
 
 #endif // __RTCDS3231_H__
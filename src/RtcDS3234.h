@@ -5,7 +5,9 @@
 #include <SPI.h>
 
 #include "RtcDateTime.h"
+#include "RtcDS323xCommon.h"
 #include "RtcTemperature.h"
+#include "RtcTimestamp.h"
 #include "RtcUtility.h"
 
 
@@ -26,6 +28,17 @@ const uint8_t DS3234_REG_TEMP        = 0x11;
 const uint8_t DS3234_REG_RAM_ADDRESS = 0x18;
 const uint8_t DS3234_REG_RAM_DATA    = 0x19;
 
+//DS3234 Register Data Size if not just 1
+const uint8_t DS3234_REG_TIMEDATE_SIZE = 7;
+const uint8_t DS3234_REG_ALARMONE_SIZE = 4;
+const uint8_t DS3234_REG_ALARMTWO_SIZE = 3;
+
+const uint8_t DS3234_REG_TEMP_SIZE     = 2;
+const uint8_t DS3234_REG_SNAPSHOT_SIZE = 0x13; // time date through temperature
+
+// SetMemory stages the caller's data in chunks of this size for the block transfers
+const uint8_t c_Ds3234MemoryChunkSize = 32;
+
 const uint8_t DS3234_RAMSTART        = 0x00;
 const uint8_t DS3234_RAMEND          = 0xff;
 const uint8_t DS3234_RAMSIZE         = DS3234_RAMEND - DS3234_RAMSTART;
@@ -52,8 +65,16 @@ const uint8_t DS3234_CRATE1   = 5;
 const uint8_t DS3234_BB32KHZ  = 6;
 const uint8_t DS3234_OSF      = 7;
 const uint8_t DS3234_AIFMASK   = (_BV(DS3234_A1F)    | _BV(DS3234_A2F));
+// flags only the hardware sets, writing a 0 clears them and writing a 1 has no effect
+const uint8_t DS3234_FLAGMASK  = (_BV(DS3234_OSF)    | DS3234_AIFMASK);
 const uint8_t DS3234_CRATEMASK = (_BV(DS3234_CRATE0) | _BV(DS3234_CRATE1));
 
+// a temperature conversion takes about 125ms and up to 200ms, so polling
+// every 10ms costs only a few bus transactions.  The timeout allows for an
+// automatic conversion that has to finish before the forced one starts
+const uint16_t c_Ds3234ConversionPollMs = 10;
+const uint16_t c_Ds3234ConversionTimeoutMs = 400;
+
 // seconds accuracy
 enum DS3234AlarmOneControl {
     // bit order:  A1M4  DY/DT  A1M3  A1M2  A1M1
@@ -223,6 +244,33 @@ enum DS3234AlarmFlag {
     DS3234AlarmFlag_AlarmBoth = 0x03,
 };
 
+// the DS3234 adds the temperature compensation rate to the status register
+class DS3234Snapshot : public RtcDS323xSnapshot<DS3234AlarmOne, DS3234AlarmTwo, DS3234AlarmFlag>
+{
+public:
+    DS3234Snapshot(const RtcDateTime& dateTime,
+            const DS3234AlarmOne& alarmOne,
+            const DS3234AlarmTwo& alarmTwo,
+            uint8_t control,
+            uint8_t status,
+            int8_t agingOffset,
+            const RtcTemperature& temperature) :
+        RtcDS323xSnapshot<DS3234AlarmOne, DS3234AlarmTwo, DS3234AlarmFlag>(dateTime,
+            alarmOne,
+            alarmTwo,
+            control,
+            status,
+            agingOffset,
+            temperature)
+    {
+    }
+
+    DS3234TempCompensationRate TemperatureCompensationRate() const
+    {
+        return (DS3234TempCompensationRate)((_status & DS3234_CRATEMASK) >> DS3234_CRATE0);
+    }
+};
+
 const SPISettings c_Ds3234SpiSettings(1000000, MSBFIRST, SPI_MODE1); // CPHA must be used, so mode 1 or mode 3 are valid
 
 template<typename T_SPI_METHOD> class RtcDS3234
@@ -230,7 +278,12 @@ template<typename T_SPI_METHOD> class RtcDS3234
 public:
     RtcDS3234(T_SPI_METHOD& spi, uint8_t csPin) :
         _spi(spi),
-        _csPin(csPin)
+        _csPin(csPin),
+        _lastError(0),
+        _conversionState(RtcAsyncState_Idle),
+        _isConversionForced(false),
+        _conversionStartMillis(0),
+        _conversionPollMillis(0)
     {
     }
 
@@ -240,6 +293,13 @@ public:
         pinMode(_csPin, OUTPUT);
     }
 
+    // SPI reports no errors, this is only set when a temperature
+    // conversion times out, as with the DS3231
+    uint8_t LastError()
+    {
+        return _lastError;
+    }
+
     bool IsDateTimeValid()
     {
         uint8_t status = getReg(DS3234_REG_STATUS);
@@ -262,73 +322,51 @@ public:
 
     void SetDateTime(const RtcDateTime& dt)
     {
+        uint8_t regs[DS3234_REG_TIMEDATE_SIZE];
+
         // clear the invalid flag
-        uint8_t status = getReg(DS3234_REG_STATUS);
-        status &= ~_BV(DS3234_OSF); // clear the flag
-        setReg(DS3234_REG_STATUS, status);
+        setStatus(getReg(DS3234_REG_STATUS), _BV(DS3234_OSF));
 
         // set the date time
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
-        _spi.transfer(DS3234_REG_TIMEDATE | DS3234_REG_WRITE_FLAG);
-
-        _spi.transfer(Uint8ToBcd(dt.Second()));
-        _spi.transfer(Uint8ToBcd(dt.Minute()));
-        _spi.transfer(Uint8ToBcd(dt.Hour())); // 24 hour mode only
-
-        uint8_t year = dt.Year() - 2000;
-        uint8_t centuryFlag = 0;
+        Ds323xEncodeDateTime(dt, regs);
+        setRegs(DS3234_REG_TIMEDATE, regs, DS3234_REG_TIMEDATE_SIZE);
+    }
 
-        if (year >= 100) {
-            year -= 100;
-            centuryFlag = _BV(7);
-        }
+    // Sets the time at the start of a whole second of a reference time that
+    // was taken at micros() referenceMicros.  Writing the seconds restarts
+    // the RTC second, the write starts early by the part of latencyMicros
+    // before the seconds are on the bus, so pass the result of an earlier
+    // call.  Waits up to a second and returns the microseconds the write took.
+    uint32_t SetDateTimeAtBoundary(const RtcTimestamp& reference, uint32_t referenceMicros, uint32_t latencyMicros = 0)
+    {
+        uint8_t regs[DS3234_REG_TIMEDATE_SIZE];
+        uint32_t startMicros;
 
-        // RTC Hardware Day of Week is 1-7, 1 = Monday
-        // convert our Day of Week to Rtc Day of Week
-        uint8_t rtcDow = RtcDateTime::ConvertDowToRtc(dt.DayOfWeek());
+        // clear the invalid flag
+        setStatus(getReg(DS3234_REG_STATUS), _BV(DS3234_OSF));
 
-        _spi.transfer(Uint8ToBcd(rtcDow));
+        // the seconds are the second of the eight bytes of the write
+        uint32_t seconds = RtcNextBoundary(reference, referenceMicros, latencyMicros / 4, &startMicros);
+        Ds323xEncodeDateTime(RtcDateTime(seconds), regs);
 
-        _spi.transfer(Uint8ToBcd(dt.Day()));
-        _spi.transfer(Uint8ToBcd(dt.Month()) | centuryFlag);
-        _spi.transfer(Uint8ToBcd(year));
-        UnselectChip();
-        _spi.endTransaction();
+        RtcWaitForMicros(startMicros);
+        uint32_t start = micros();
+        setRegs(DS3234_REG_TIMEDATE, regs, DS3234_REG_TIMEDATE_SIZE);
+        return micros() - start;
     }
 
     RtcDateTime GetDateTime()
     {
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
-
-        _spi.transfer(DS3234_REG_TIMEDATE);
-
-        uint8_t second = BcdToUint8(_spi.transfer(0));
-        uint8_t minute = BcdToUint8(_spi.transfer(0));
-        uint8_t hour = BcdToBin24Hour(_spi.transfer(0));
-
-        _spi.transfer(0); // throwing away day of week as we calculate it
-
-        uint8_t dayOfMonth = BcdToUint8(_spi.transfer(0));
-        uint8_t monthRaw = _spi.transfer(0);
-        uint16_t year = BcdToUint8(_spi.transfer(0)) + 2000;
-
-        UnselectChip();
-        _spi.endTransaction();
+        uint8_t regs[DS3234_REG_TIMEDATE_SIZE];
 
-        if (monthRaw & _BV(7)) // century wrap flag
-            year += 100;
-        uint8_t month = BcdToUint8(monthRaw & 0x7f);
+        getRegs(DS3234_REG_TIMEDATE, regs, DS3234_REG_TIMEDATE_SIZE);
 
-        return RtcDateTime(year, month, dayOfMonth, hour, minute, second);
+        return Ds323xDecodeDateTime(regs);
     }
 
     RtcTemperature GetTemperature()
     {
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
-        _spi.transfer(DS3234_REG_TEMP);
+        uint8_t regs[DS3234_REG_TEMP_SIZE];
 
         // Temperature is represented as a 10-bit code with a resolution
         // of 1/4th C and is accessable as a signed 16-bit integer at
@@ -344,13 +382,45 @@ public:
         // For example, at +/- 25.25C, concatenated registers <r11h:r12h> =
         // 256 * (+/- 25+(1/4)) = +/- 6464, or 1940h / E6C0h.
 
-        int8_t  ms = _spi.transfer(0);  // MS byte, signed temperature
-        uint8_t ls = _spi.transfer(0);  // LS byte is r12h
+        getRegs(DS3234_REG_TEMP, regs, DS3234_REG_TEMP_SIZE);
 
-        UnselectChip();
-        _spi.endTransaction();
+        return Ds323xDecodeTemperature(regs);
+    }
+
+    // with forceConversion the temperature is measured by a new conversion,
+    // sleeping while it completes rather than spinning on the bus
+    RtcTemperature GetTemperature(bool forceConversion)
+    {
+        if (forceConversion) {
+            if (!StartTemperatureConversion())
+                return RtcTemperature(0);
+
+            while (ProcessTemperatureConversion() == RtcAsyncState_Busy)
+                delay(c_Ds3234ConversionPollMs);
+
+            return CompleteTemperatureConversion();
+        }
 
-        return RtcTemperature(ms, ls);  // LS byte is r12h
+        return GetTemperature();
+    }
+
+    // Reads every register from time date through temperature within one
+    // chip select, replacing the separate GetDateTime, GetAlarmOne,
+    // GetAlarmTwo, IsDateTimeValid, GetAgingOffset and GetTemperature
+    // transactions
+    DS3234Snapshot GetSnapshot()
+    {
+        uint8_t regs[DS3234_REG_SNAPSHOT_SIZE];
+
+        getRegs(DS3234_REG_TIMEDATE, regs, DS3234_REG_SNAPSHOT_SIZE);
+
+        return DS3234Snapshot(Ds323xDecodeDateTime(regs + DS3234_REG_TIMEDATE),
+                Ds323xDecodeAlarmOne<DS3234AlarmOne>(regs + DS3234_REG_ALARMONE),
+                Ds323xDecodeAlarmTwo<DS3234AlarmTwo>(regs + DS3234_REG_ALARMTWO),
+                regs[DS3234_REG_CONTROL],
+                regs[DS3234_REG_STATUS],
+                regs[DS3234_REG_AGING],
+                Ds323xDecodeTemperature(regs + DS3234_REG_TEMP));
     }
 
     void Enable32kHzPin(bool enable)
@@ -358,7 +428,7 @@ public:
         uint8_t sreg = getReg(DS3234_REG_STATUS);
         if (enable) sreg |= _BV(DS3234_EN32KHZ);
         else        sreg &= ~_BV(DS3234_EN32KHZ);
-        setReg(DS3234_REG_STATUS, sreg);
+        setStatus(sreg, 0);
     }
 
     void SetSquareWavePin(DS3234SquareWavePinMode pinMode)
@@ -411,104 +481,54 @@ public:
 
     void SetAlarmOne(const DS3234AlarmOne& alarm)
     {
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
+        uint8_t regs[DS3234_REG_ALARMONE_SIZE];
 
-        _spi.transfer(DS3234_REG_ALARMONE | DS3234_REG_WRITE_FLAG);
-
-        _spi.transfer(Uint8ToBcd(alarm.Second()) | ((alarm.ControlFlags() & 0x01) << 7));
-        _spi.transfer(Uint8ToBcd(alarm.Minute()) | ((alarm.ControlFlags() & 0x02) << 6));
-        _spi.transfer(Uint8ToBcd(alarm.Hour()) | ((alarm.ControlFlags() & 0x04) << 5)); // 24 hour mode only
+        regs[0] = Uint8ToBcd(alarm.Second()) | ((alarm.ControlFlags() & 0x01) << 7);
+        regs[1] = Uint8ToBcd(alarm.Minute()) | ((alarm.ControlFlags() & 0x02) << 6);
+        regs[2] = Uint8ToBcd(alarm.Hour()) | ((alarm.ControlFlags() & 0x04) << 5); // 24 hour mode only
 
         uint8_t rtcDow = alarm.DayOf();
         if (alarm.ControlFlags() == DS3234AlarmOneControl_HoursMinutesSecondsDayOfWeekMatch)
             rtcDow = RtcDateTime::ConvertDowToRtc(rtcDow);
 
-        _spi.transfer(Uint8ToBcd(rtcDow) | ((alarm.ControlFlags() & 0x18) << 3));
+        regs[3] = Uint8ToBcd(rtcDow) | ((alarm.ControlFlags() & 0x18) << 3);
 
-        UnselectChip();
-        _spi.endTransaction();
+        setRegs(DS3234_REG_ALARMONE, regs, DS3234_REG_ALARMONE_SIZE);
     }
 
     void SetAlarmTwo(const DS3234AlarmTwo& alarm)
     {
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
+        uint8_t regs[DS3234_REG_ALARMTWO_SIZE];
 
-        _spi.transfer(DS3234_REG_ALARMTWO | DS3234_REG_WRITE_FLAG);
-
-        _spi.transfer(Uint8ToBcd(alarm.Minute()) | ((alarm.ControlFlags() & 0x01) << 7));
-        _spi.transfer(Uint8ToBcd(alarm.Hour()) | ((alarm.ControlFlags() & 0x02) << 6)); // 24 hour mode only
+        regs[0] = Uint8ToBcd(alarm.Minute()) | ((alarm.ControlFlags() & 0x01) << 7);
+        regs[1] = Uint8ToBcd(alarm.Hour()) | ((alarm.ControlFlags() & 0x02) << 6); // 24 hour mode only
 
         // convert our Day of Week to Rtc Day of Week if needed
         uint8_t rtcDow = alarm.DayOf();
         if (alarm.ControlFlags() == DS3234AlarmTwoControl_HoursMinutesDayOfWeekMatch)
             rtcDow = RtcDateTime::ConvertDowToRtc(rtcDow);
-        
-        _spi.transfer(Uint8ToBcd(rtcDow) | ((alarm.ControlFlags() & 0x0c) << 4));
 
-        UnselectChip();
-        _spi.endTransaction();
+        regs[2] = Uint8ToBcd(rtcDow) | ((alarm.ControlFlags() & 0x0c) << 4);
+
+        setRegs(DS3234_REG_ALARMTWO, regs, DS3234_REG_ALARMTWO_SIZE);
     }
 
     DS3234AlarmOne GetAlarmOne()
     {
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
-
-        _spi.transfer(DS3234_REG_ALARMONE);
-  
-        uint8_t raw = _spi.transfer(0);
-        uint8_t flags = (raw & 0x80) >> 7;
-        uint8_t second = BcdToUint8(raw & 0x7f);
-
-        raw = _spi.transfer(0);
-        flags |= (raw & 0x80) >> 6;
-        uint8_t minute = BcdToUint8(raw & 0x7f);
-
-        raw = _spi.transfer(0);
-        flags |= (raw & 0x80) >> 5;
-        uint8_t hour = BcdToBin24Hour(raw & 0x7f);
-
-        raw = _spi.transfer(0);
-        flags |= (raw & 0xc0) >> 3;
-        uint8_t dayOf = BcdToUint8(raw & 0x3f);
-
-        UnselectChip();
-        _spi.endTransaction();
+        uint8_t regs[DS3234_REG_ALARMONE_SIZE];
 
-        if (flags == DS3234AlarmOneControl_HoursMinutesSecondsDayOfWeekMatch)
-            dayOf = RtcDateTime::ConvertRtcToDow(dayOf);
+        getRegs(DS3234_REG_ALARMONE, regs, DS3234_REG_ALARMONE_SIZE);
 
-        return DS3234AlarmOne(dayOf, hour, minute, second, (DS3234AlarmOneControl)flags);
+        return Ds323xDecodeAlarmOne<DS3234AlarmOne>(regs);
     }
 
     DS3234AlarmTwo GetAlarmTwo()
     {
-        _spi.beginTransaction(c_Ds3234SpiSettings);
-        SelectChip();
-
-        _spi.transfer(DS3234_REG_ALARMTWO);
-
-        uint8_t raw = _spi.transfer(0);
-        uint8_t flags = (raw & 0x80) >> 7;
-        uint8_t minute = BcdToUint8(raw & 0x7f);
-
-        raw = _spi.transfer(0);
-        flags |= (raw & 0x80) >> 6;
-        uint8_t hour = BcdToBin24Hour(raw & 0x7f);
+        uint8_t regs[DS3234_REG_ALARMTWO_SIZE];
 
-        raw = _spi.transfer(0);
-        flags |= (raw & 0xc0) >> 4;
-        uint8_t dayOf = BcdToUint8(raw & 0x3f);
+        getRegs(DS3234_REG_ALARMTWO, regs, DS3234_REG_ALARMTWO_SIZE);
 
-        UnselectChip();
-        _spi.endTransaction();
-
-        if (flags == DS3234AlarmTwoControl_HoursMinutesDayOfWeekMatch)
-            dayOf = RtcDateTime::ConvertRtcToDow(dayOf);
-
-        return DS3234AlarmTwo(dayOf, hour, minute, (DS3234AlarmTwoControl)flags);
+        return Ds323xDecodeAlarmTwo<DS3234AlarmTwo>(regs);
     }
 
     // Latch must be called after an alarm otherwise it will not
@@ -517,8 +537,7 @@ public:
     {
         uint8_t sreg = getReg(DS3234_REG_STATUS);
         uint8_t alarmFlags = (sreg & DS3234_AIFMASK);
-        sreg &= ~DS3234_AIFMASK; // clear the flags
-        setReg(DS3234_REG_STATUS, sreg);
+        setStatus(sreg, DS3234_AIFMASK);
         return (DS3234AlarmFlag)alarmFlags;
     }
 
@@ -529,7 +548,7 @@ public:
         sreg &= ~DS3234_CRATEMASK;
         sreg |= (rate << DS3234_CRATE0);
 
-        setReg(DS3234_REG_STATUS, sreg);
+        setStatus(sreg, 0);
     }
 
     DS3234TempCompensationRate GetTemperatureCompensationRate()
@@ -540,13 +559,88 @@ public:
 
     void ForceTemperatureCompensationUpdate(bool block)
     {
-        uint8_t creg = getReg(DS3234_REG_CONTROL);
-        creg |= _BV(DS3234_CONV); // Write CONV bit
-        setReg(DS3234_REG_CONTROL, creg);
+        if (!block) {
+            uint8_t creg = getReg(DS3234_REG_CONTROL);
+            creg |= _BV(DS3234_CONV); // Write CONV bit
+            setReg(DS3234_REG_CONTROL, creg);
+            return;
+        }
 
-        while (block && (creg & _BV(DS3234_CONV)))
-            // Block until CONV is 0
-            creg = getReg(DS3234_REG_CONTROL);
+        // a conversion already started by StartTemperatureConversion()
+        // updates the compensation too, wait for it and leave its result
+        // for CompleteTemperatureConversion()
+        if (_conversionState == RtcAsyncState_Busy) {
+            while (ProcessTemperatureConversion() == RtcAsyncState_Busy)
+                delay(c_Ds3234ConversionPollMs);
+            return;
+        }
+
+        // sleep between the polls rather than spinning on the bus
+        if (StartTemperatureConversion()) {
+            while (ProcessTemperatureConversion() == RtcAsyncState_Busy)
+                delay(c_Ds3234ConversionPollMs);
+        }
+        _conversionState = RtcAsyncState_Idle;
+    }
+
+    // Non blocking temperature conversion.  Start forces a conversion, or
+    // defers it while an automatic one is busy, and ProcessTemperatureConversion()
+    // checks on it no more than every c_Ds3234ConversionPollMs, so it can be
+    // called on every pass of the caller's loop.
+    //
+    //   rtc.StartTemperatureConversion();
+    //   ...
+    //   if (rtc.ProcessTemperatureConversion() == RtcAsyncState_Complete)
+    //       temperature = rtc.CompleteTemperatureConversion();
+    bool StartTemperatureConversion()
+    {
+        _lastError = 0;
+        _conversionStartMillis = millis();
+        _conversionPollMillis = _conversionStartMillis;
+        _isConversionForced = false;
+        _conversionState = RtcAsyncState_Busy;
+
+        forceConversion();
+        return (_conversionState == RtcAsyncState_Busy);
+    }
+
+    RtcAsyncState ProcessTemperatureConversion()
+    {
+        if (_conversionState != RtcAsyncState_Busy)
+            return _conversionState;
+
+        uint32_t now = millis();
+        if (now - _conversionPollMillis < c_Ds3234ConversionPollMs)
+            return _conversionState;
+        _conversionPollMillis = now;
+
+        if (!_isConversionForced) {
+            forceConversion();
+        }
+        else {
+            // CONV is cleared by the hardware once the conversion completes
+            uint8_t creg = getReg(DS3234_REG_CONTROL);
+            if (!(creg & _BV(DS3234_CONV)))
+                _conversionState = RtcAsyncState_Complete;
+        }
+
+        if (_conversionState == RtcAsyncState_Busy &&
+                now - _conversionStartMillis > c_Ds3234ConversionTimeoutMs) {
+            _lastError = c_RtcWireTimeoutError;
+            _conversionState = RtcAsyncState_Error;
+        }
+
+        return _conversionState;
+    }
+
+    // the temperature measured by the conversion
+    RtcTemperature CompleteTemperatureConversion()
+    {
+        if (_conversionState != RtcAsyncState_Complete)
+            return RtcTemperature(0);
+
+        _conversionState = RtcAsyncState_Idle;
+        return GetTemperature();
     }
 
     int8_t GetAgingOffset()
@@ -573,19 +667,30 @@ public:
         return value;
     }
 
-    uint8_t SetMemory(uint8_t memoryAddress, const uint8_t* pValue, uint8_t countBytes)
+    // the SRAM address wraps from 0xff to 0x00
+    uint16_t SetMemory(uint8_t memoryAddress, const uint8_t* pValue, uint16_t countBytes)
     {
-        uint8_t countWritten = 0;
-
-        setReg(DS3234_REG_RAM_ADDRESS, memoryAddress);
+        uint8_t chunk[c_Ds3234MemoryChunkSize];
+        uint16_t countWritten = countBytes;
 
         _spi.beginTransaction(c_Ds3234SpiSettings);
         SelectChip();
-        _spi.transfer(DS3234_REG_RAM_DATA | DS3234_REG_WRITE_FLAG);
 
-        while (countBytes--) {
-            _spi.transfer(*pValue++);
-            ++countWritten;
+        // the register address increments from the SRAM address to the
+        // SRAM data register, so the address and data share one chip select
+        chunk[0] = DS3234_REG_RAM_ADDRESS | DS3234_REG_WRITE_FLAG;
+        chunk[1] = memoryAddress;
+        _spi.transfer(chunk, 2);
+
+        // the transfer overwrites the buffer, so the data is staged in chunks
+        while (countBytes) {
+            uint8_t countChunk = (countBytes < c_Ds3234MemoryChunkSize) ? countBytes : c_Ds3234MemoryChunkSize;
+
+            memcpy(chunk, pValue, countChunk);
+            _spi.transfer(chunk, countChunk);
+
+            pValue += countChunk;
+            countBytes -= countChunk;
         }
 
         UnselectChip();
@@ -594,29 +699,34 @@ public:
         return countWritten;
     }
 
-    uint8_t GetMemory(uint8_t memoryAddress, uint8_t* pValue, uint8_t countBytes)
+    uint16_t GetMemory(uint8_t memoryAddress, uint8_t* pValue, uint16_t countBytes)
     {
-        // set address to read from
+        // set address to read from, a chip select either writes or reads
+        // so this can not share the data burst
         setReg(DS3234_REG_RAM_ADDRESS, memoryAddress);
 
+        // read the data
+        memset(pValue, 0, countBytes);
+
         _spi.beginTransaction(c_Ds3234SpiSettings);
         SelectChip();
         _spi.transfer(DS3234_REG_RAM_DATA);
-
-        // read the data
-        uint8_t countRead = countBytes;
-        while (countBytes--)
-            *pValue++ = _spi.transfer(0);
-
+        _spi.transfer(pValue, countBytes);
         UnselectChip();
         _spi.endTransaction();
 
-        return countRead;
+        return countBytes;
     }
 
 private:
     T_SPI_METHOD& _spi;
     uint8_t _csPin;
+    uint8_t _lastError;
+
+    RtcAsyncState _conversionState;
+    bool _isConversionForced;
+    uint32_t _conversionStartMillis;
+    uint32_t _conversionPollMillis;
 
     void SelectChip()
     {
@@ -627,6 +737,28 @@ private:
         digitalWrite(_csPin, HIGH);
     }
 
+    void setStatus(uint8_t sreg, uint8_t flagsToClear)
+    {
+        // the hardware flags are written as 1 unless being cleared, so any
+        // flag raised since sreg was read is not lost
+        sreg |= DS3234_FLAGMASK;
+        sreg &= ~flagsToClear;
+        setReg(DS3234_REG_STATUS, sreg);
+    }
+
+    // CONV is ignored while BSY reports an automatic conversion, so that
+    // has to finish first
+    void forceConversion()
+    {
+        uint8_t sreg = getReg(DS3234_REG_STATUS);
+        if (!(sreg & _BV(DS3234_BSY))) {
+            uint8_t creg = getReg(DS3234_REG_CONTROL);
+            creg |= _BV(DS3234_CONV);
+            setReg(DS3234_REG_CONTROL, creg);
+            _isConversionForced = true;
+        }
+    }
+
     uint8_t getReg(uint8_t regAddress)
     {
         _spi.beginTransaction(c_Ds3234SpiSettings);
@@ -639,6 +771,33 @@ private:
         return regValue;
     }
 
+    // burst read of consecutive registers, the register address auto
+    // increments for as long as the chip stays selected.  The bytes are
+    // moved as one block so the SPI hardware can stream them
+    void getRegs(uint8_t regAddress, uint8_t* pValues, uint8_t countBytes)
+    {
+        memset(pValues, 0, countBytes);
+
+        _spi.beginTransaction(c_Ds3234SpiSettings);
+        SelectChip();
+        _spi.transfer(regAddress);
+        _spi.transfer(pValues, countBytes);
+        UnselectChip();
+        _spi.endTransaction();
+    }
+
+    // burst write of consecutive registers, pValues is overwritten by the
+    // bytes shifted in
+    void setRegs(uint8_t regAddress, uint8_t* pValues, uint8_t countBytes)
+    {
+        _spi.beginTransaction(c_Ds3234SpiSettings);
+        SelectChip();
+        _spi.transfer(regAddress | DS3234_REG_WRITE_FLAG);
+        _spi.transfer(pValues, countBytes);
+        UnselectChip();
+        _spi.endTransaction();
+    }
+
     void setReg(uint8_t regAddress, uint8_t regValue)
     {
         _spi.beginTransaction(c_Ds3234SpiSettings);
@@ -648,7 +807,6 @@ private:
         UnselectChip();
         _spi.endTransaction();
     }
-
 };
 
 #endif // __RTCDS3234_H__
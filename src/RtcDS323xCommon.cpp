@@ -0,0 +1,50 @@
+#include <Arduino.h>
+#include "RtcDS323xCommon.h"
+
+void Ds323xEncodeDateTime(const RtcDateTime& dt, uint8_t* regs)
+{
+    regs[0] = Uint8ToBcd(dt.Second());
+    regs[1] = Uint8ToBcd(dt.Minute());
+    regs[2] = Uint8ToBcd(dt.Hour()); // 24 hour mode only
+
+    uint8_t year = dt.Year() - 2000;
+    uint8_t centuryFlag = 0;
+
+    if (year >= 100) {
+        year -= 100;
+        centuryFlag = _BV(7);
+    }
+
+    // RTC Hardware Day of Week is 1-7, 1 = Monday
+    // convert our Day of Week to Rtc Day of Week
+    regs[3] = Uint8ToBcd(RtcDateTime::ConvertDowToRtc(dt.DayOfWeek()));
+
+    regs[4] = Uint8ToBcd(dt.Day());
+    regs[5] = Uint8ToBcd(dt.Month()) | centuryFlag;
+    regs[6] = Uint8ToBcd(year);
+}
+
+RtcDateTime Ds323xDecodeDateTime(const uint8_t* regs)
+{
+    uint8_t second = BcdToUint8(regs[0] & 0x7f);
+    uint8_t minute = BcdToUint8(regs[1]);
+    uint8_t hour = BcdToBin24Hour(regs[2]);
+
+    // regs[3] is the day of week, throwing it away as we calculate it
+
+    uint8_t dayOfMonth = BcdToUint8(regs[4]);
+    uint8_t monthRaw = regs[5];
+    uint16_t year = BcdToUint8(regs[6]) + 2000;
+
+    if (monthRaw & _BV(7)) // century wrap flag
+        year += 100;
+    uint8_t month = BcdToUint8(monthRaw & 0x7f);
+
+    return RtcDateTime(year, month, dayOfMonth, hour, minute, second);
+}
+
+RtcTemperature Ds323xDecodeTemperature(const uint8_t* regs)
+{
+    // MS byte is r11h, signed temperature, LS byte is r12h
+    return RtcTemperature((int8_t)regs[0], regs[1]);
+}
@@ -0,0 +1,163 @@
+#ifndef __RTCDS323XCOMMON_H__
+#define __RTCDS323XCOMMON_H__
+
+#include <Arduino.h>
+
+#include "RtcDateTime.h"
+#include "RtcTemperature.h"
+#include "RtcUtility.h"
+
+// The DS3231 and DS3234 share the register file from time date through
+// temperature, only the bus in front of it differs.  The encoding of those
+// registers and the snapshot of them are kept here, parameterized on the
+// alarm classes of each chip.
+
+// bits the snapshot reports, the same on both chips
+const uint8_t DS323X_EOSC = 7;        // control
+const uint8_t DS323X_OSF = 7;         // status
+const uint8_t DS323X_AIFMASK = 0x03;  // status, A1F A2F
+
+// the control flags of a day of week match, see the AlarmOneControl and
+// AlarmTwoControl enums
+const uint8_t DS323X_ALARMONE_DAYOFWEEK = 0x08;
+const uint8_t DS323X_ALARMTWO_DAYOFWEEK = 0x04;
+
+extern void Ds323xEncodeDateTime(const RtcDateTime& dt, uint8_t* regs);
+extern RtcDateTime Ds323xDecodeDateTime(const uint8_t* regs);
+extern RtcTemperature Ds323xDecodeTemperature(const uint8_t* regs);
+
+// the control enum of the alarm is taken from its ControlFlags()
+template<typename T_ALARM_ONE, typename T_CONTROL> T_ALARM_ONE Ds323xMakeAlarmOne(const uint8_t* regs,
+    T_CONTROL (T_ALARM_ONE::*)() const)
+{
+    uint8_t flags = (regs[0] & 0x80) >> 7;
+    uint8_t second = BcdToUint8(regs[0] & 0x7f);
+
+    flags |= (regs[1] & 0x80) >> 6;
+    uint8_t minute = BcdToUint8(regs[1] & 0x7f);
+
+    flags |= (regs[2] & 0x80) >> 5;
+    uint8_t hour = BcdToBin24Hour(regs[2] & 0x7f);
+
+    flags |= (regs[3] & 0xc0) >> 3;
+    uint8_t dayOf = BcdToUint8(regs[3] & 0x3f);
+
+    if (flags == DS323X_ALARMONE_DAYOFWEEK)
+        dayOf = RtcDateTime::ConvertRtcToDow(dayOf);
+
+    return T_ALARM_ONE(dayOf, hour, minute, second, static_cast<T_CONTROL>(flags));
+}
+
+template<typename T_ALARM_TWO, typename T_CONTROL> T_ALARM_TWO Ds323xMakeAlarmTwo(const uint8_t* regs,
+    T_CONTROL (T_ALARM_TWO::*)() const)
+{
+    uint8_t flags = (regs[0] & 0x80) >> 7;
+    uint8_t minute = BcdToUint8(regs[0] & 0x7f);
+
+    flags |= (regs[1] & 0x80) >> 6;
+    uint8_t hour = BcdToBin24Hour(regs[1] & 0x7f);
+
+    flags |= (regs[2] & 0xc0) >> 4;
+    uint8_t dayOf = BcdToUint8(regs[2] & 0x3f);
+
+    if (flags == DS323X_ALARMTWO_DAYOFWEEK)
+        dayOf = RtcDateTime::ConvertRtcToDow(dayOf);
+
+    return T_ALARM_TWO(dayOf, hour, minute, static_cast<T_CONTROL>(flags));
+}
+
+template<typename T_ALARM_ONE> T_ALARM_ONE Ds323xDecodeAlarmOne(const uint8_t* regs)
+{
+    return Ds323xMakeAlarmOne(regs, &T_ALARM_ONE::ControlFlags);
+}
+
+template<typename T_ALARM_TWO> T_ALARM_TWO Ds323xDecodeAlarmTwo(const uint8_t* regs)
+{
+    return Ds323xMakeAlarmTwo(regs, &T_ALARM_TWO::ControlFlags);
+}
+
+// every register from time date through temperature, decoded from one burst read
+template<typename T_ALARM_ONE, typename T_ALARM_TWO, typename T_ALARM_FLAG> class RtcDS323xSnapshot
+{
+public:
+    RtcDS323xSnapshot(const RtcDateTime& dateTime,
+            const T_ALARM_ONE& alarmOne,
+            const T_ALARM_TWO& alarmTwo,
+            uint8_t control,
+            uint8_t status,
+            int8_t agingOffset,
+            const RtcTemperature& temperature) :
+        _dateTime(dateTime),
+        _alarmOne(alarmOne),
+        _alarmTwo(alarmTwo),
+        _temperature(temperature),
+        _control(control),
+        _status(status),
+        _agingOffset(agingOffset)
+    {
+    }
+
+    const RtcDateTime& DateTime() const
+    {
+        return _dateTime;
+    }
+
+    const T_ALARM_ONE& AlarmOne() const
+    {
+        return _alarmOne;
+    }
+
+    const T_ALARM_TWO& AlarmTwo() const
+    {
+        return _alarmTwo;
+    }
+
+    const RtcTemperature& Temperature() const
+    {
+        return _temperature;
+    }
+
+    // raw control register
+    uint8_t Control() const
+    {
+        return _control;
+    }
+
+    // raw status register
+    uint8_t Status() const
+    {
+        return _status;
+    }
+
+    int8_t AgingOffset() const
+    {
+        return _agingOffset;
+    }
+
+    bool IsDateTimeValid() const
+    {
+        return !(_status & _BV(DS323X_OSF));
+    }
+
+    bool GetIsRunning() const
+    {
+        return !(_control & _BV(DS323X_EOSC));
+    }
+
+    // the flags are only reported, use LatchAlarmsTriggeredFlags() to clear them
+    T_ALARM_FLAG AlarmsTriggeredFlags() const
+    {
+        return (T_ALARM_FLAG)(_status & DS323X_AIFMASK);
+    }
+
+protected:
+    RtcDateTime _dateTime;
+    T_ALARM_ONE _alarmOne;
+    T_ALARM_TWO _alarmTwo;
+    RtcTemperature _temperature;
+    uint8_t _control;
+    uint8_t _status;
+    int8_t _agingOffset;
+};
+
+#endif // __RTCDS323XCOMMON_H__
@@ -18,13 +18,24 @@ enum DayOfWeek {
 
 const uint16_t c_OriginYear = 2000;
 const uint32_t c_Epoch32OfOriginYear = 946684800;
-extern const uint8_t c_daysInMonth[] PROGMEM;
+// days from 0000-03-01 to 2000-01-01, the civil calendar day count of the origin year
+const uint32_t c_CivilDaysOfOriginYear = 730425;
+
+// parse the decimal number at the start of the string, skipping leading zeros and spaces
+constexpr uint8_t StringToUint8(const char* pString, uint8_t value = 0)
+{
+    return (*pString >= '0' && *pString <= '9') ?
+            StringToUint8(pString + 1, value * 10 + (*pString - '0')) :
+        (*pString == ' ' && value == 0) ?
+            StringToUint8(pString + 1, value) :
+            value;
+}
 
 class RtcDateTime
 {
 public:
     RtcDateTime(uint32_t secondsFrom2000 = 0);
-    RtcDateTime(uint16_t year,
+    constexpr RtcDateTime(uint16_t year,
         uint8_t month,
         uint8_t dayOfMonth,
         uint8_t hour,
@@ -39,8 +50,18 @@ public:
     {
     }
 
-    // RtcDateTime compileDateTime(__DATE__, __TIME__);
-    RtcDateTime(const char* date, const char* time);
+    // parsed at compile time when used as a constant
+    // constexpr RtcDateTime compileDateTime(__DATE__, __TIME__);
+    constexpr RtcDateTime(const char* date, const char* time) :
+        // sample input: date = "Dec 06 2009", time = "12:34:56"
+        _yearFrom2000(StringToUint8(date + 9)),
+        _month(_monthFromString(date)),
+        _dayOfMonth(StringToUint8(date + 4)),
+        _hour(StringToUint8(time)),
+        _minute(StringToUint8(time + 3)),
+        _second(StringToUint8(time + 6))
+    {
+    }
 
     bool IsValid() const;
 
@@ -69,41 +90,53 @@ public:
         _second = second;
     }
 
-    uint16_t Year() const
+    constexpr uint16_t Year() const
     {
         return c_OriginYear + _yearFrom2000;
     }
-    uint8_t Month() const
+    constexpr uint8_t Month() const
     {
         return _month;
     }
-    uint8_t Day() const
+    constexpr uint8_t Day() const
     {
         return _dayOfMonth;
     }
-    uint8_t Hour() const
+    constexpr uint8_t Hour() const
     {
         return _hour;
     }
-    uint8_t Minute() const
+    constexpr uint8_t Minute() const
     {
         return _minute;
     }
-    uint8_t Second() const
+    constexpr uint8_t Second() const
     {
         return _second;
     }
     // 0 = Sunday, 1 = Monday, ... 6 = Saturday
-    uint8_t DayOfWeek() const;
+    constexpr uint8_t DayOfWeek() const
+    {
+        return (_daysSinceFirstOfYear2000() + 6) % 7; // Jan 1, 2000 is a Saturday, i.e. returns 6
+    }
 
     // 32-bit time; as seconds since 1/1/2000
-    uint32_t TotalSeconds() const;
+    constexpr uint32_t TotalSeconds() const
+    {
+        return ((_daysSinceFirstOfYear2000() * 24 + _hour) * 60 + _minute) * 60 + _second;
+    }
 
     // 64-bit time; as seconds since 1/1/2000
-    uint64_t TotalSeconds64() const;
+    constexpr uint64_t TotalSeconds64() const
+    {
+        return (((uint64_t)_daysSinceFirstOfYear2000() * 24 + _hour) * 60 + _minute) * 60 + _second;
+    }
 
     // total days since 1/1/2000
-    uint16_t TotalDays() const;
+    constexpr uint16_t TotalDays() const
+    {
+        return _daysSinceFirstOfYear2000();
+    }
     
     // add seconds
     void operator+=(uint32_t seconds)
@@ -120,13 +153,13 @@ public:
     }
 
     // allows for comparisons to just work (==, <, >, <=, >=, !=)
-    operator uint32_t() const
+    constexpr operator uint32_t() const
     {
         return TotalSeconds();
     }
 
     // Epoch32 support
-    uint32_t Epoch32Time() const
+    constexpr uint32_t Epoch32Time() const
     {
         return TotalSeconds() + c_Epoch32OfOriginYear;
     }
@@ -136,7 +169,7 @@ public:
     }
 
     // Epoch64 support
-    uint64_t Epoch64Time() const
+    constexpr uint64_t Epoch64Time() const
     {
         return TotalSeconds64() + c_Epoch32OfOriginYear;
     }
@@ -150,13 +183,13 @@ public:
     
     // convert our Day of Week to Rtc Day of Week 
     // RTC Hardware Day of Week is 1-7, 1 = Monday
-    static uint8_t ConvertDowToRtc(uint8_t dow)
+    static constexpr uint8_t ConvertDowToRtc(uint8_t dow)
     {
         return dow ? dow : 7;
     }
 
     // convert Rtc Day of Week to our Day of Week
-    static uint8_t ConvertRtcToDow(uint8_t rtcDow)
+    static constexpr uint8_t ConvertRtcToDow(uint8_t rtcDow)
     {
         return rtcDow % 7;
     }
@@ -169,6 +202,48 @@ protected:
     uint8_t _minute;
     uint8_t _second;
 
+    bool _IsValidLeapSecond() const;
+
+    // closed form civil date to days, the inverse of _initWithSecondsFrom2000
+    // see http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+    // (written as single expressions so they remain C++11 constexpr)
+    constexpr uint32_t _daysSinceFirstOfYear2000() const
+    {
+        return _daysFromCivil(c_OriginYear + _yearFrom2000 - (_month <= 2), _month, _dayOfMonth);
+    }
+
+    static constexpr uint32_t _daysFromCivil(uint32_t civilYear, uint8_t month, uint8_t dayOfMonth)
+    {
+        return (civilYear / 400) * 146097 +
+            _dayOfEra(civilYear % 400, _dayOfYear(month, dayOfMonth)) -
+            c_CivilDaysOfOriginYear;
+    }
+
+    // [0, 146096]
+    static constexpr uint32_t _dayOfEra(uint32_t yearOfEra, uint32_t dayOfYear)
+    {
+        return yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    }
+
+    // [0, 365], counted from March 1st
+    static constexpr uint32_t _dayOfYear(uint8_t month, uint8_t dayOfMonth)
+    {
+        return (153 * ((month > 2) ? month - 3 : month + 9) + 2) / 5 + dayOfMonth - 1;
+    }
+
+    // Jan Feb Mar Apr May Jun Jul Aug Sep Oct Nov Dec
+    static constexpr uint8_t _monthFromString(const char* month)
+    {
+        return (month[0] == 'J') ? ((month[1] == 'a') ? 1 : (month[2] == 'n') ? 6 : 7) :
+            (month[0] == 'F') ? 2 :
+            (month[0] == 'A') ? ((month[1] == 'p') ? 4 : 8) :
+            (month[0] == 'M') ? ((month[2] == 'r') ? 3 : 5) :
+            (month[0] == 'S') ? 9 :
+            (month[0] == 'O') ? 10 :
+            (month[0] == 'N') ? 11 :
+            (month[0] == 'D') ? 12 : 0;
+    }
+
     template<typename T> void _initWithSecondsFrom2000(T secondsFrom2000)
     {
         _second = secondsFrom2000 % 60;
@@ -176,22 +251,21 @@ protected:
         _minute = timeFrom2000 % 60;
         timeFrom2000 /= 60;
         _hour = timeFrom2000 % 24;
-        T days = timeFrom2000 / 24;
-        T leapDays;
-
-        for (_yearFrom2000 = 0;;++_yearFrom2000) {
-            leapDays = (_yearFrom2000 % 4 == 0) ? 1 : 0;
-            if (days < 365U + leapDays) break;
-            days -= 365 + leapDays;
-        }
-        for (_month = 1;;++_month) {
-            uint8_t daysPerMonth = pgm_read_byte(c_daysInMonth + _month - 1);
-            if (leapDays && _month == 2)
-                ++daysPerMonth;
-            if (days < daysPerMonth) break;
-            days -= daysPerMonth;
-        }
-        _dayOfMonth = days + 1;
+        T days = timeFrom2000 / 24 + c_CivilDaysOfOriginYear;
+
+        // closed form days to civil date, constant time regardless of the distance
+        // from 2000.  Years are counted in 400 year eras that start on March 1st so
+        // the leap day is always the last day of the year
+        // see http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+        T era = days / 146097;
+        uint32_t dayOfEra = days - era * 146097; // [0, 146096]
+        uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365; // [0, 399]
+        uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100); // [0, 365]
+        uint8_t monthFromMarch = (5 * dayOfYear + 2) / 153; // [0, 11]
+
+        _dayOfMonth = dayOfYear - (153 * monthFromMarch + 2) / 5 + 1;
+        _month = (monthFromMarch < 10) ? monthFromMarch + 3 : monthFromMarch - 9;
+        _yearFrom2000 = era * 400 + yearOfEra + (_month <= 2) - c_OriginYear;
     }
 
 };
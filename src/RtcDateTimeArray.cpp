@@ -0,0 +1,131 @@
+#include <Arduino.h>
+#include "RtcDateTime.h"
+#include "RtcDateTimeArray.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+// Each block is split into days and seconds of the day, then every calendar
+// field is calculated into its own array using only 32-bit lanes and selects
+// (no branches or table lookups), so each loop can be vectorized.  The fields
+// are only gathered into the packed RtcDateTime array at the end.
+const size_t c_DateTimeArrayBlockSize = 16;
+
+struct DateTimeBlock
+{
+    uint32_t days[c_DateTimeArrayBlockSize];
+    uint32_t secondsOfDay[c_DateTimeArrayBlockSize];
+};
+
+static void DateTimesFromBlock(RtcDateTime* pDateTimes, const DateTimeBlock& block, size_t count)
+{
+    uint32_t years[c_DateTimeArrayBlockSize];
+    uint32_t months[c_DateTimeArrayBlockSize];
+    uint32_t daysOfMonth[c_DateTimeArrayBlockSize];
+
+    // closed form days to civil date, see RtcDateTime::_initWithSecondsFrom2000
+    for (size_t index = 0; index < c_DateTimeArrayBlockSize; ++index)
+    {
+        uint32_t days = block.days[index] + c_CivilDaysOfOriginYear;
+        uint32_t era = days / 146097;
+        uint32_t dayOfEra = days - era * 146097;
+        uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        uint32_t monthFromMarch = (5 * dayOfYear + 2) / 153;
+        uint32_t month = (monthFromMarch < 10) ? monthFromMarch + 3 : monthFromMarch - 9;
+
+        daysOfMonth[index] = dayOfYear - (153 * monthFromMarch + 2) / 5 + 1;
+        months[index] = month;
+        years[index] = era * 400 + yearOfEra + (month <= 2);
+    }
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        uint32_t secondsOfDay = block.secondsOfDay[index];
+
+        pDateTimes[index] = RtcDateTime(years[index],
+            months[index],
+            daysOfMonth[index],
+            secondsOfDay / 3600,
+            (secondsOfDay / 60) % 60,
+            secondsOfDay % 60);
+    }
+}
+
+template<typename T> static void DateTimesFromSeconds(RtcDateTime* pDateTimes, const T* pTimes, T offset, size_t count)
+{
+    DateTimeBlock block;
+
+    while (count)
+    {
+        size_t blockCount = (count < c_DateTimeArrayBlockSize) ? count : c_DateTimeArrayBlockSize;
+
+        // a partial block is padded out so the field loops always run full width
+        for (size_t index = 0; index < c_DateTimeArrayBlockSize; ++index)
+        {
+            T secondsFrom2000 = pTimes[(index < blockCount) ? index : 0] - offset;
+
+            block.days[index] = secondsFrom2000 / 86400;
+            block.secondsOfDay[index] = secondsFrom2000 % 86400;
+        }
+
+        DateTimesFromBlock(pDateTimes, block, blockCount);
+
+        pDateTimes += blockCount;
+        pTimes += blockCount;
+        count -= blockCount;
+    }
+}
+
+void RtcDateTimesFromSeconds(RtcDateTime* pDateTimes, const uint32_t* pSecondsFrom2000, size_t count)
+{
+    DateTimesFromSeconds<uint32_t>(pDateTimes, pSecondsFrom2000, 0, count);
+}
+
+void RtcDateTimesFromEpoch32(RtcDateTime* pDateTimes, const uint32_t* pEpoch32, size_t count)
+{
+    DateTimesFromSeconds<uint32_t>(pDateTimes, pEpoch32, c_Epoch32OfOriginYear, count);
+}
+
+void RtcDateTimesFromEpoch64(RtcDateTime* pDateTimes, const uint64_t* pEpoch64, size_t count)
+{
+    DateTimesFromSeconds<uint64_t>(pDateTimes, pEpoch64, c_Epoch32OfOriginYear, count);
+}
+
+#else // no vector unit to feed, convert one at a time
+
+void RtcDateTimesFromSeconds(RtcDateTime* pDateTimes, const uint32_t* pSecondsFrom2000, size_t count)
+{
+    while (count--) *pDateTimes++ = RtcDateTime(*pSecondsFrom2000++);
+}
+
+void RtcDateTimesFromEpoch32(RtcDateTime* pDateTimes, const uint32_t* pEpoch32, size_t count)
+{
+    while (count--) (pDateTimes++)->InitWithEpoch32Time(*pEpoch32++);
+}
+
+void RtcDateTimesFromEpoch64(RtcDateTime* pDateTimes, const uint64_t* pEpoch64, size_t count)
+{
+    while (count--) (pDateTimes++)->InitWithEpoch64Time(*pEpoch64++);
+}
+
+#endif
+
+// the reverse direction is already branch free per element, written as plain
+// loops the compiler can vectorize where it is able to
+void RtcDateTimesToSeconds(uint32_t* pSecondsFrom2000, const RtcDateTime* pDateTimes, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+        pSecondsFrom2000[index] = pDateTimes[index].TotalSeconds();
+}
+
+void RtcDateTimesToEpoch32(uint32_t* pEpoch32, const RtcDateTime* pDateTimes, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+        pEpoch32[index] = pDateTimes[index].Epoch32Time();
+}
+
+void RtcDateTimesToEpoch64(uint64_t* pEpoch64, const RtcDateTime* pDateTimes, size_t count)
+{
+    for (size_t index = 0; index < count; ++index)
+        pEpoch64[index] = pDateTimes[index].Epoch64Time();
+}
@@ -0,0 +1,22 @@
+#ifndef __RTCDATETIMEARRAY_H__
+#define __RTCDATETIMEARRAY_H__
+
+#include "RtcDateTime.h"
+
+// Conversions of whole arrays of times to and from RtcDateTime
+//
+// These produce the same results as converting one element at a time, but
+// on x86-64 hosts the work is done in blocks with branch free arithmetic
+// so the compiler can vectorize it.  On microcontrollers they are simple loops.
+//
+// pSeconds* arrays are seconds since 1/1/2000, as RtcDateTime::TotalSeconds()
+
+extern void RtcDateTimesFromSeconds(RtcDateTime* pDateTimes, const uint32_t* pSecondsFrom2000, size_t count);
+extern void RtcDateTimesFromEpoch32(RtcDateTime* pDateTimes, const uint32_t* pEpoch32, size_t count);
+extern void RtcDateTimesFromEpoch64(RtcDateTime* pDateTimes, const uint64_t* pEpoch64, size_t count);
+
+extern void RtcDateTimesToSeconds(uint32_t* pSecondsFrom2000, const RtcDateTime* pDateTimes, size_t count);
+extern void RtcDateTimesToEpoch32(uint32_t* pEpoch32, const RtcDateTime* pDateTimes, size_t count);
+extern void RtcDateTimesToEpoch64(uint64_t* pEpoch64, const RtcDateTime* pDateTimes, size_t count);
+
+#endif // __RTCDATETIMEARRAY_H__
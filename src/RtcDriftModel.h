@@ -0,0 +1,183 @@
+#ifndef __RTCDRIFTMODEL_H__
+#define __RTCDRIFTMODEL_H__
+
+#include <Arduino.h>
+
+#include "RtcDateTime.h"
+#include "RtcTemperature.h"
+#include "RtcTimestamp.h"
+
+// a 32768Hz tuning fork crystal runs fastest at the turnover temperature
+// and slows with the square of the distance from it
+const float c_RtcCrystalTurnoverC = 25.0f;
+const float c_RtcCrystalPpmPerC2 = -0.034f;
+// the RTC second always changes within this while aligning to it
+const uint16_t c_RtcDriftAlignTimeoutMs = 1100;
+// the RTC is read this often while aligning, the edge is known to half of it
+const uint8_t c_RtcDriftAlignPollMs = 10;
+
+// Predicts the drift of an uncompensated RTC such as the DS1307 or DS1302
+// from the temperature of its crystal, from a DS3231 or DS3234 or any other
+// sensor, and corrects the time read through it.
+//
+// The frequency error is offsetPpm + curvature * (T - turnover)^2, it is
+// integrated over the time between temperature samples by millis().  The
+// model has GetDateTime() and LastError() so it can stand in for the RTC,
+// as under RtcClock, and WriteBack() moves the RTC onto the corrected time
+// once the error has grown, so the chip itself stays close.  WriteBack()
+// blocks while it finds the edge of the RTC second and waits for the true
+// one, give it a tick clock on the square wave of the RTC to skip the first.
+//
+// RtcDriftModel<RtcDS1307<TwoWire>> Model(Rtc);
+// RtcClock<RtcDriftModel<RtcDS1307<TwoWire>>> Clock(Model);
+// ...
+// Model.AddTemperature(Sensor.GetTemperature()); // every few minutes
+// Model.WriteBack();
+template<typename T_RTC> class RtcDriftModel
+{
+public:
+    RtcDriftModel(T_RTC& rtc,
+            float offsetPpm = 0.0f,
+            float turnoverC = c_RtcCrystalTurnoverC,
+            float curvaturePpmPerC2 = c_RtcCrystalPpmPerC2,
+            uint32_t writeBackMicros = 500000) :
+        _rtc(rtc),
+        _offsetPpm(offsetPpm),
+        _turnoverC(turnoverC),
+        _curvaturePpmPerC2(curvaturePpmPerC2),
+        _writeBackMicros(writeBackMicros),
+        _hasSample(false),
+        _sampleMillis(0),
+        _samplePpm(0.0f),
+        _errorMicros(0.0f),
+        _latencyMicros(0)
+    {
+    }
+
+    // the frequency error at a temperature, negative when the RTC runs slow
+    float DriftPpm(const RtcTemperature& temperature) const
+    {
+        float delta = temperature.AsFloatDegC() - _turnoverC;
+        return _offsetPpm + _curvaturePpmPerC2 * delta * delta;
+    }
+
+    // the first sample starts the model, each one after adds the drift since
+    // the last at the mean of the two
+    void AddTemperature(const RtcTemperature& temperature)
+    {
+        uint32_t now = millis();
+        float ppm = DriftPpm(temperature);
+
+        if (_hasSample) {
+            // ppm is microseconds per second
+            float seconds = static_cast<float>(now - _sampleMillis) / 1000.0f;
+            _errorMicros += (_samplePpm + ppm) * 0.5f * seconds;
+        }
+
+        _hasSample = true;
+        _sampleMillis = now;
+        _samplePpm = ppm;
+    }
+
+    // how far the RTC is ahead of the true time, negative when behind
+    int32_t ErrorMicros() const
+    {
+        return static_cast<int32_t>(_errorMicros);
+    }
+
+    // the RTC time less the whole seconds of the error
+    RtcDateTime GetDateTime()
+    {
+        int32_t seconds = static_cast<int32_t>(_errorMicros / 1000000.0f + ((_errorMicros < 0) ? -0.5f : 0.5f));
+
+        return RtcDateTime(_rtc.GetDateTime().TotalSeconds() - seconds);
+    }
+
+    // of the last read of the RTC
+    uint8_t LastError()
+    {
+        return _rtc.LastError();
+    }
+
+    // Once the error is beyond the write back limit, waits for the RTC second
+    // to change, which is when the RTC time is exact, and writes the
+    // corrected time at the next true second.  Blocks for up to two seconds,
+    // reading the RTC every c_RtcDriftAlignPollMs while it waits for the
+    // edge.  False when there was nothing to do or the RTC second did not
+    // change.
+    bool WriteBack()
+    {
+        if (!isWriteBackDue()) return false;
+
+        uint32_t readMicros = micros();
+        uint32_t seconds = _rtc.GetDateTime().TotalSeconds();
+        uint32_t start = millis();
+
+        while (millis() - start < c_RtcDriftAlignTimeoutMs) {
+            uint32_t lastReadMicros = readMicros;
+
+            delay(c_RtcDriftAlignPollMs);
+            readMicros = micros();
+            uint32_t next = _rtc.GetDateTime().TotalSeconds();
+
+            if (next != seconds) {
+                // the second changed between the starts of the two reads
+                return writeBack(next, lastReadMicros + (readMicros - lastReadMicros) / 2);
+            }
+        }
+        return false;
+    }
+
+    // As WriteBack(), with the edge of the RTC second taken from a clock
+    // ticked by the square wave of the RTC, such as RtcTickClock, so only
+    // the wait for the true second blocks.  The write moves the RTC
+    // seconds, so Begin() the clock again after it.  False when there was
+    // nothing to do or the clock missed its last tick.
+    template<typename T_TICK_CLOCK> bool WriteBack(const T_TICK_CLOCK& clock)
+    {
+        if (!isWriteBackDue()) return false;
+
+        uint32_t sinceTick;
+        uint32_t seconds = clock.NowSeconds(&sinceTick);
+        uint32_t edgeMicros = micros() - sinceTick;
+
+        if (sinceTick >= 999999) return false;
+        return writeBack(seconds, edgeMicros);
+    }
+
+private:
+    T_RTC& _rtc;
+    const float _offsetPpm;
+    const float _turnoverC;
+    const float _curvaturePpmPerC2;
+    const uint32_t _writeBackMicros;
+
+    bool _hasSample;
+    uint32_t _sampleMillis;
+    float _samplePpm;
+    float _errorMicros;
+    uint32_t _latencyMicros;
+
+    bool isWriteBackDue() const
+    {
+        return (_errorMicros >= _writeBackMicros || _errorMicros <= -static_cast<float>(_writeBackMicros));
+    }
+
+    // seconds is the RTC time that started at micros() edgeMicros
+    bool writeBack(uint32_t seconds, uint32_t edgeMicros)
+    {
+        // the true time at the edge is the RTC time less the error
+        int32_t ticks = static_cast<int32_t>(_errorMicros * (c_RtcTimestampFractionsPerSecond / 1000000.0f));
+        int32_t whole = (ticks >= 0) ? (ticks >> c_RtcTimestampFractionBits) :
+            -((-ticks + c_RtcTimestampFractionsPerSecond - 1) >> c_RtcTimestampFractionBits);
+        uint16_t fraction = ticks - whole * c_RtcTimestampFractionsPerSecond;
+
+        RtcTimestamp reference(seconds - whole - 1, c_RtcTimestampFractionsPerSecond - fraction);
+
+        _latencyMicros = _rtc.SetDateTimeAtBoundary(reference, edgeMicros, _latencyMicros);
+        _errorMicros = 0.0f;
+        return true;
+    }
+};
+
+#endif // __RTCDRIFTMODEL_H__
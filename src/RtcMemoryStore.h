@@ -0,0 +1,337 @@
+#ifndef __RTCMEMORYSTORE_H__
+#define __RTCMEMORYSTORE_H__
+
+#include <Arduino.h>
+
+#include "RtcUtility.h"
+
+// Bank layout
+//
+// [0]  sequence, the bank with the later sequence is current
+// [1]  CRC8 of the sequence and the entries, written last to commit
+// [2-] entries of key, length, value bytes and the CRC8 of those, ended by
+//      the key 0xff or the end of the bank
+const uint8_t c_MemoryStoreKeyNone = 0xff;
+const uint8_t c_MemoryStoreHeaderSize = 2;
+const uint8_t c_MemoryStoreEntryOverhead = 3;
+// the CRCs start from this so that neither zeroed nor erased memory is valid
+const uint8_t c_MemoryStoreCrcSeed = 0x5a;
+// unchanged bytes between two changes cheaper to write than to re-address
+const uint8_t c_MemoryStoreRunGap = 2;
+
+// A small key/value store in the battery backed RAM of an RTC, or any
+// memory with SetMemory(address, pValue, count) and
+// GetMemory(address, pValue, count), such as RtcDS1307, RtcDS1302,
+// RtcDS3234 and EepromAt24c32.
+//
+// The memory holds two banks of V_BANK_SIZE bytes.  An update is built in
+// RAM and written to the older bank, only the bytes that differ from what
+// that bank already holds are sent, and its header is written last.  A
+// reset part way through leaves the header of that bank invalid, so Begin()
+// falls back to the other bank.  Reads come from the RAM copy, call Begin()
+// before anything else.
+//
+// RtcMemoryStore<RtcDS1307<TwoWire>, 28> Store(Rtc); // all 56 bytes
+template<typename T_MEMORY, uint8_t V_BANK_SIZE> class RtcMemoryStore
+{
+public:
+    static_assert(V_BANK_SIZE > c_MemoryStoreHeaderSize + c_MemoryStoreEntryOverhead,
+        "the bank is too small for an entry");
+
+    RtcMemoryStore(T_MEMORY& memory, uint16_t startAddress = 0) :
+        _memory(memory),
+        _startAddress(startAddress),
+        _current(0)
+    {
+        for (uint8_t bank = 0; bank < 2; bank++) {
+            memset(_banks[bank], c_MemoryStoreKeyNone, V_BANK_SIZE);
+            _isValid[bank] = false;
+        }
+    }
+
+    // reads both banks and picks the latest valid one, an empty store when
+    // neither is valid
+    bool Begin()
+    {
+        for (uint8_t bank = 0; bank < 2; bank++) {
+            if (!readBank(bank)) return false;
+            _isValid[bank] = isBankValid(_banks[bank]);
+        }
+
+        _current = 0;
+        if (_isValid[1] && (!_isValid[0] || static_cast<int8_t>(_banks[1][0] - _banks[0][0]) > 0)) {
+            _current = 1;
+        }
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        return (!_isValid[_current] || _banks[_current][c_MemoryStoreHeaderSize] == c_MemoryStoreKeyNone);
+    }
+
+    // returns the length of the stored value, 0 when the key is not stored,
+    // at most countBytes are copied
+    uint8_t Get(uint8_t key, uint8_t* pValue, uint8_t countBytes) const
+    {
+        if (!_isValid[_current]) return 0;
+
+        const uint8_t* pBank = _banks[_current];
+        uint8_t position = findEntry(pBank, key);
+
+        if (position == 0) return 0;
+
+        uint8_t length = pBank[position + 1];
+
+        memcpy(pValue, pBank + position + 2, (countBytes < length) ? countBytes : length);
+        return length;
+    }
+
+    // false when it does not fit or could not be written
+    bool Set(uint8_t key, const uint8_t* pValue, uint8_t countBytes)
+    {
+        if (key == c_MemoryStoreKeyNone) return false;
+
+        uint8_t image[V_BANK_SIZE];
+
+        if (!buildImage(image, key, pValue, countBytes)) return false;
+
+        return commit(image);
+    }
+
+    bool Remove(uint8_t key)
+    {
+        if (!_isValid[_current] || findEntry(_banks[_current], key) == 0) return true;
+
+        uint8_t image[V_BANK_SIZE];
+
+        buildImage(image, key, NULL, 0);
+
+        return commit(image);
+    }
+
+    // removes every key
+    bool Clear()
+    {
+        uint8_t image[V_BANK_SIZE];
+
+        memcpy(image, _banks[_current ^ 1], V_BANK_SIZE);
+        finishImage(image, c_MemoryStoreHeaderSize);
+
+        return commit(image);
+    }
+
+    // the bytes left for entries, each entry takes 3 bytes more than its value
+    uint8_t Available() const
+    {
+        return V_BANK_SIZE - usedSize(_banks[_current]);
+    }
+
+private:
+    T_MEMORY& _memory;
+    const uint16_t _startAddress;
+
+    uint8_t _banks[2][V_BANK_SIZE]; // what each bank in memory holds
+    bool _isValid[2];
+    uint8_t _current;
+
+    uint16_t bankAddress(uint8_t bank) const
+    {
+        return _startAddress + bank * V_BANK_SIZE;
+    }
+
+    bool readBank(uint8_t bank)
+    {
+        return (_memory.GetMemory(bankAddress(bank), _banks[bank], V_BANK_SIZE) == V_BANK_SIZE);
+    }
+
+    // the end of the valid entries, 0 if any entry is damaged
+    static uint8_t entriesEnd(const uint8_t* pBank)
+    {
+        uint8_t position = c_MemoryStoreHeaderSize;
+
+        while (position < V_BANK_SIZE && pBank[position] != c_MemoryStoreKeyNone) {
+            if (V_BANK_SIZE - position < c_MemoryStoreEntryOverhead) return 0;
+
+            uint8_t size = pBank[position + 1] + c_MemoryStoreEntryOverhead;
+
+            if (size > V_BANK_SIZE - position) return 0;
+            if (RtcCrc8(pBank + position, size - 1, c_MemoryStoreCrcSeed) != pBank[position + size - 1]) return 0;
+
+            position += size;
+        }
+
+        return position;
+    }
+
+    static uint8_t bankCrc(const uint8_t* pBank, uint8_t end)
+    {
+        uint8_t crc = RtcCrc8(pBank, 1, c_MemoryStoreCrcSeed);
+
+        return RtcCrc8(pBank + c_MemoryStoreHeaderSize, end - c_MemoryStoreHeaderSize, crc);
+    }
+
+    static bool isBankValid(const uint8_t* pBank)
+    {
+        uint8_t end = entriesEnd(pBank);
+
+        return (end != 0 && bankCrc(pBank, end) == pBank[1]);
+    }
+
+    // the position of the entry, 0 when not found
+    static uint8_t findEntry(const uint8_t* pBank, uint8_t key)
+    {
+        uint8_t position = c_MemoryStoreHeaderSize;
+
+        while (position < V_BANK_SIZE && pBank[position] != c_MemoryStoreKeyNone) {
+            if (pBank[position] == key) return position;
+
+            position += pBank[position + 1] + c_MemoryStoreEntryOverhead;
+        }
+
+        return 0;
+    }
+
+    uint8_t usedSize(const uint8_t* pBank) const
+    {
+        if (!_isValid[_current]) return c_MemoryStoreHeaderSize;
+
+        return entriesEnd(pBank);
+    }
+
+    // the current entries with the key replaced in place, or removed when
+    // pValue is NULL, the bytes past the end are left as the older bank holds
+    // them so they are not written
+    bool buildImage(uint8_t* pImage, uint8_t key, const uint8_t* pValue, uint8_t countBytes)
+    {
+        uint8_t other = _current ^ 1;
+        uint8_t position = c_MemoryStoreHeaderSize;
+        bool isAdded = (pValue == NULL);
+
+        memcpy(pImage, _banks[other], V_BANK_SIZE);
+
+        if (_isValid[_current]) {
+            const uint8_t* pBank = _banks[_current];
+            uint8_t end = entriesEnd(pBank);
+            uint8_t from = c_MemoryStoreHeaderSize;
+
+            while (from < end) {
+                uint8_t size = pBank[from + 1] + c_MemoryStoreEntryOverhead;
+
+                if (pBank[from] == key) {
+                    if (!isAdded) {
+                        if (!addEntry(pImage, &position, key, pValue, countBytes)) return false;
+                        isAdded = true;
+                    }
+                }
+                else {
+                    if (size > V_BANK_SIZE - position) return false;
+                    memcpy(pImage + position, pBank + from, size);
+                    position += size;
+                }
+                from += size;
+            }
+        }
+
+        if (!isAdded && !addEntry(pImage, &position, key, pValue, countBytes)) return false;
+
+        finishImage(pImage, position);
+        return true;
+    }
+
+    void finishImage(uint8_t* pImage, uint8_t end)
+    {
+        if (end < V_BANK_SIZE) {
+            pImage[end] = c_MemoryStoreKeyNone;
+        }
+
+        pImage[0] = _isValid[_current] ? _banks[_current][0] + 1 : 0;
+        pImage[1] = bankCrc(pImage, end);
+    }
+
+    static bool addEntry(uint8_t* pImage, uint8_t* pPosition, uint8_t key, const uint8_t* pValue, uint8_t countBytes)
+    {
+        uint8_t position = *pPosition;
+
+        if (countBytes + c_MemoryStoreEntryOverhead > V_BANK_SIZE - position) return false;
+
+        pImage[position] = key;
+        pImage[position + 1] = countBytes;
+        memcpy(pImage + position + 2, pValue, countBytes);
+        pImage[position + 2 + countBytes] = RtcCrc8(pImage + position, countBytes + 2, c_MemoryStoreCrcSeed);
+
+        *pPosition = position + countBytes + c_MemoryStoreEntryOverhead;
+        return true;
+    }
+
+    bool writeRange(uint8_t bank, uint8_t start, uint8_t end, const uint8_t* pImage)
+    {
+        uint8_t countBytes = end - start;
+
+        if (_memory.SetMemory(bankAddress(bank) + start, pImage + start, countBytes) != countBytes)
+            return false;
+
+        memcpy(_banks[bank] + start, pImage + start, countBytes);
+        return true;
+    }
+
+    // writes the image to the older bank and makes it current
+    bool commit(const uint8_t* pImage)
+    {
+        uint8_t bank = _current ^ 1;
+        uint8_t* pBank = _banks[bank];
+
+        // the header must not vouch for a half written bank
+        if (_isValid[bank] && memcmp(pBank + c_MemoryStoreHeaderSize,
+                pImage + c_MemoryStoreHeaderSize,
+                V_BANK_SIZE - c_MemoryStoreHeaderSize) != 0) {
+            uint8_t invalid[c_MemoryStoreHeaderSize] = { pBank[0], static_cast<uint8_t>(~pBank[1]) };
+
+            _isValid[bank] = false;
+            if (!writeRange(bank, 1, 2, invalid)) return failCommit(bank);
+        }
+
+        // only the runs of changed bytes
+        uint8_t position = c_MemoryStoreHeaderSize;
+
+        while (position < V_BANK_SIZE) {
+            if (pBank[position] == pImage[position]) {
+                position++;
+                continue;
+            }
+
+            uint8_t start = position;
+            uint8_t end = position + 1;
+
+            for (position = end; position < V_BANK_SIZE && position - end <= c_MemoryStoreRunGap; position++) {
+                if (pBank[position] != pImage[position]) {
+                    end = position + 1;
+                }
+            }
+
+            if (!writeRange(bank, start, end, pImage)) return failCommit(bank);
+            position = end;
+        }
+
+        if (memcmp(pBank, pImage, c_MemoryStoreHeaderSize) != 0 &&
+                !writeRange(bank, 0, c_MemoryStoreHeaderSize, pImage)) {
+            return failCommit(bank);
+        }
+
+        _isValid[bank] = true;
+        _current = bank;
+        return true;
+    }
+
+    // what was written is unknown, so the bank is read back
+    bool failCommit(uint8_t bank)
+    {
+        _isValid[bank] = false;
+        if (readBank(bank)) {
+            _isValid[bank] = isBankValid(_banks[bank]);
+        }
+        return false;
+    }
+};
+
+#endif // __RTCMEMORYSTORE_H__
@@ -16,8 +16,8 @@ public:
     // Bit:     15 14 13 12 11 10  9  8  7  6  5  4  3  2   .  1  0  -1 -2
     //           s  s  s  s  s  s  s  i  i  i  i  i  i  i      f  f   0  0
     RtcTemperature(int8_t highByteDegreesC, uint8_t lowByteDegreesC) :
-        #define HIGH_LOW_TO_DEG_C(hi, lo) (((((int16_t)hi) << 8 | (((int16_t)lo) & 0xc0) >> 6)) * 100 / 4)
-        _centiDegC(HIGH_LOW_TO_DEG_C(highByteDegreesC, lowByteDegressC))
+        #define HIGH_LOW_TO_DEG_C(hi, lo) (((((int16_t)hi) << 8 | (((int16_t)lo) & 0xc0)) >> 6) * 100 / 4)
+        _centiDegC(HIGH_LOW_TO_DEG_C(highByteDegreesC, lowByteDegreesC))
         #undef HIGH_LOW_TO_DEG_C
     {
     }
@@ -0,0 +1,157 @@
+#ifndef __RTCTICKCLOCK_H__
+#define __RTCTICKCLOCK_H__
+
+#include <Arduino.h>
+
+#include "RtcUtility.h"
+#include "RtcDateTime.h"
+
+// orders the sequence and data accesses of the tick against the readers,
+// only the ESP32 has a second core that can read during the tick
+#if defined(ARDUINO_ARCH_ESP32)
+#define RTC_TICK_BARRIER() __sync_synchronize()
+#else
+#define RTC_TICK_BARRIER() __asm__ __volatile__("" ::: "memory")
+#endif
+
+// Publishes what a tick interrupt writes to readers outside of it.  The
+// count is odd while the tick is writing, a reader that sees it odd or
+// changed retries, so reading never disables interrupts.
+//
+// uint8_t sequence;
+// do {
+//     sequence = Sequence.BeginRead();
+//     ... read the data
+// } while (Sequence.IsReadTorn(sequence));
+class RtcTickSequence
+{
+public:
+    RtcTickSequence() :
+        _sequence(0)
+    {
+    }
+
+    void ISR_ATTR BeginWrite()
+    {
+        _sequence = _sequence + 1;
+        RTC_TICK_BARRIER();
+    }
+
+    void ISR_ATTR EndWrite()
+    {
+        RTC_TICK_BARRIER();
+        _sequence = _sequence + 1;
+    }
+
+    uint8_t BeginRead() const
+    {
+        uint8_t sequence = _sequence;
+        RTC_TICK_BARRIER();
+        return sequence;
+    }
+
+    // true when a tick wrote during the read, which must then be repeated
+    bool IsReadTorn(uint8_t sequence) const
+    {
+        RTC_TICK_BARRIER();
+        return (sequence & 1) || sequence != _sequence;
+    }
+
+    // Reads the RTC seconds with no tick during the read, as a tick may
+    // have been before or after the seconds changed.  Returns with
+    // interrupts disabled, so the caller writes its seed before the next
+    // tick and then enables them.
+    template<typename T_RTC> uint32_t ReadRtcSeconds(T_RTC& rtc)
+    {
+        for (;;) {
+            uint8_t sequence = _sequence;
+            uint32_t seconds = rtc.GetDateTime().TotalSeconds();
+
+            noInterrupts();
+            if (sequence == _sequence) return seconds;
+            interrupts();
+        }
+    }
+
+private:
+    volatile uint8_t _sequence;
+};
+
+// A seconds counter driven by the 1Hz square wave of the RTC, such as
+// DS3231SquareWaveClock_1Hz or DS1307SquareWaveOut_1Hz.  The seconds
+// register changes on the falling edge, so call Tick() from the interrupt
+// for that edge.
+//
+// Reading the time never uses the bus and never disables interrupts, the
+// tick is published through an RtcTickSequence.
+//
+// RtcTickClock Clock;
+// void ISR_ATTR OnSecond() { Clock.Tick(); }
+// attachInterrupt(digitalPinToInterrupt(pin), OnSecond, FALLING);
+// Clock.Begin(Rtc);
+class RtcTickClock
+{
+public:
+    RtcTickClock() :
+        _seconds(0),
+        _tickMicros(0)
+    {
+    }
+
+    // seeds the counter from the RTC, call after the interrupt is attached
+    template<typename T_RTC> void Begin(T_RTC& rtc)
+    {
+        uint32_t seconds = _sequence.ReadRtcSeconds(rtc);
+
+        write(seconds, micros());
+        interrupts();
+    }
+
+    void ISR_ATTR Tick()
+    {
+        write(_seconds + 1, micros());
+    }
+
+    // seconds since 2000, the same as RtcDateTime::TotalSeconds(), and
+    // optionally the microseconds since the last tick
+    uint32_t NowSeconds(uint32_t* pMicroseconds = NULL) const
+    {
+        uint8_t sequence;
+        uint32_t seconds;
+        uint32_t tickMicros;
+
+        do {
+            sequence = _sequence.BeginRead();
+            seconds = _seconds;
+            tickMicros = _tickMicros;
+        } while (_sequence.IsReadTorn(sequence));
+
+        if (pMicroseconds) {
+            uint32_t elapsed = micros() - tickMicros;
+
+            // a missed tick is not made up
+            *pMicroseconds = (elapsed < 1000000) ? elapsed : 999999;
+        }
+        return seconds;
+    }
+
+    RtcDateTime Now() const
+    {
+        return RtcDateTime(NowSeconds());
+    }
+
+private:
+    RtcTickSequence _sequence;
+    volatile uint32_t _seconds;
+    volatile uint32_t _tickMicros;
+
+    void ISR_ATTR write(uint32_t seconds, uint32_t tickMicros)
+    {
+        _sequence.BeginWrite();
+        _seconds = seconds;
+        _tickMicros = tickMicros;
+        _sequence.EndWrite();
+    }
+};
+
+#endif // __RTCTICKCLOCK_H__
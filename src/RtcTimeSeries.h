@@ -0,0 +1,503 @@
+#ifndef __RTCTIMESERIES_H__
+#define __RTCTIMESERIES_H__
+
+#include <Arduino.h>
+
+#include "RtcDateTime.h"
+
+// Block layout
+//
+// [0-3] TotalSeconds() of the first sample, little endian
+// [4]   count of samples, 0xff when the block is unused (erased)
+// [5-]  the first value, then for each following sample the change in the
+//       time between samples (delta of delta) and the change in the value,
+//       all as zigzag varints
+//
+// Samples taken at a steady interval need a single byte for the time and
+// slowly changing values a single byte for the value.
+const uint8_t c_TimeSeriesHeaderSize = 5;
+const uint8_t c_TimeSeriesCountUnused = 0xff;
+const uint8_t c_TimeSeriesVarintMaxSize = 5;
+
+class RtcTimeSeriesCodec
+{
+public:
+    static uint32_t ZigZagEncode(int32_t value)
+    {
+        return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    }
+
+    static int32_t ZigZagDecode(uint32_t value)
+    {
+        return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+    }
+
+    // the change from previous to value, false when it does not fit an int32
+    static bool Difference(int64_t value, int32_t previous, int32_t* pDifference)
+    {
+        int64_t difference = value - previous;
+
+        if (static_cast<int32_t>(difference) != difference) return false;
+
+        *pDifference = static_cast<int32_t>(difference);
+        return true;
+    }
+
+    // returns the bytes used, at most c_TimeSeriesVarintMaxSize
+    static uint8_t VarintEncode(uint32_t value, uint8_t* pBuffer)
+    {
+        uint8_t count = 0;
+
+        while (value >= 0x80) {
+            pBuffer[count++] = (value & 0x7f) | 0x80;
+            value >>= 7;
+        }
+        pBuffer[count++] = value;
+
+        return count;
+    }
+
+    // returns the bytes used, 0 if it runs past the end
+    static uint8_t VarintDecode(const uint8_t* pBuffer, uint8_t countBytes, uint32_t* pValue)
+    {
+        uint32_t value = 0;
+
+        for (uint8_t index = 0; index < countBytes && index < c_TimeSeriesVarintMaxSize; index++) {
+            value |= static_cast<uint32_t>(pBuffer[index] & 0x7f) << (index * 7);
+            if ((pBuffer[index] & 0x80) == 0) {
+                *pValue = value;
+                return index + 1;
+            }
+        }
+
+        return 0;
+    }
+
+    static void SetUint32(uint8_t* pValue, uint32_t value)
+    {
+        pValue[0] = value;
+        pValue[1] = value >> 8;
+        pValue[2] = value >> 16;
+        pValue[3] = value >> 24;
+    }
+
+    static uint32_t GetUint32(const uint8_t* pValue)
+    {
+        return pValue[0] |
+            (static_cast<uint32_t>(pValue[1]) << 8) |
+            (static_cast<uint32_t>(pValue[2]) << 16) |
+            (static_cast<uint32_t>(pValue[3]) << 24);
+    }
+};
+
+// Walks the samples of an encoded block
+class RtcTimeSeriesDecoder
+{
+public:
+    RtcTimeSeriesDecoder(const uint8_t* pBlock, uint8_t blockSize) :
+        _pBlock(pBlock),
+        _blockSize(blockSize),
+        _index(0),
+        _position(c_TimeSeriesHeaderSize),
+        _seconds(0),
+        _delta(0),
+        _value(0)
+    {
+    }
+
+    uint8_t Count() const
+    {
+        return (_pBlock[4] == c_TimeSeriesCountUnused) ? 0 : _pBlock[4];
+    }
+
+    // the bytes used by the samples decoded so far
+    uint8_t Position() const
+    {
+        return _position;
+    }
+
+    bool Next(uint32_t* pSeconds, int32_t* pValue)
+    {
+        if (_index >= Count()) return false;
+
+        uint32_t encoded;
+        uint8_t used;
+
+        if (_index == 0) {
+            _seconds = RtcTimeSeriesCodec::GetUint32(_pBlock);
+        }
+        else {
+            used = RtcTimeSeriesCodec::VarintDecode(_pBlock + _position, _blockSize - _position, &encoded);
+            if (used == 0) return false;
+            _position += used;
+
+            _delta += RtcTimeSeriesCodec::ZigZagDecode(encoded);
+            _seconds += _delta;
+        }
+
+        used = RtcTimeSeriesCodec::VarintDecode(_pBlock + _position, _blockSize - _position, &encoded);
+        if (used == 0) return false;
+        _position += used;
+
+        _value += RtcTimeSeriesCodec::ZigZagDecode(encoded);
+        _index++;
+
+        *pSeconds = _seconds;
+        *pValue = _value;
+        return true;
+    }
+
+private:
+    const uint8_t* _pBlock;
+    const uint8_t _blockSize;
+    uint8_t _index;
+    uint8_t _position;
+    uint32_t _seconds;
+    int32_t _delta;
+    int32_t _value;
+};
+
+// Builds an encoded block in RAM
+template<uint8_t V_BLOCK_SIZE> class RtcTimeSeriesEncoder
+{
+public:
+    static_assert(V_BLOCK_SIZE > c_TimeSeriesHeaderSize + c_TimeSeriesVarintMaxSize,
+        "the block is too small for a sample");
+
+    RtcTimeSeriesEncoder()
+    {
+        Reset();
+    }
+
+    void Reset()
+    {
+        memset(_block, 0xff, sizeof(_block));
+        _block[4] = 0;
+        _position = c_TimeSeriesHeaderSize;
+        _seconds = 0;
+        _delta = 0;
+        _value = 0;
+    }
+
+    // continues a block that was already encoded
+    bool Load(const uint8_t* pBlock)
+    {
+        RtcTimeSeriesDecoder decoder(pBlock, V_BLOCK_SIZE);
+        uint32_t seconds;
+        int32_t value;
+        int32_t delta = 0;
+        uint8_t count = 0;
+
+        Reset();
+        while (decoder.Next(&seconds, &value)) {
+            if (count > 0) {
+                delta = seconds - _seconds;
+            }
+            _seconds = seconds;
+            _value = value;
+            count++;
+        }
+        if (count != decoder.Count()) return false;
+
+        _position = decoder.Position();
+        memcpy(_block, pBlock, _position);
+        _delta = delta;
+        return true;
+    }
+
+    // false when the sample does not fit, goes back in time or changes by
+    // more than an int32 holds, the block is left unchanged so the sample
+    // can start the next block
+    bool Add(uint32_t seconds, int32_t value)
+    {
+        uint8_t encoded[c_TimeSeriesVarintMaxSize * 2];
+        uint8_t count = 0;
+        uint8_t samples = _block[4];
+        int32_t delta = 0;
+        int32_t change;
+
+        if (samples == c_TimeSeriesCountUnused - 1) return false;
+
+        if (samples > 0) {
+            int32_t deltaChange;
+
+            if (seconds < _seconds) return false;
+            if (!RtcTimeSeriesCodec::Difference(seconds - _seconds, 0, &delta)) return false;
+            if (!RtcTimeSeriesCodec::Difference(delta, _delta, &deltaChange)) return false;
+
+            count += RtcTimeSeriesCodec::VarintEncode(RtcTimeSeriesCodec::ZigZagEncode(deltaChange), encoded);
+        }
+        if (!RtcTimeSeriesCodec::Difference(value, _value, &change)) return false;
+        count += RtcTimeSeriesCodec::VarintEncode(RtcTimeSeriesCodec::ZigZagEncode(change), encoded + count);
+
+        if (count > V_BLOCK_SIZE - _position) return false;
+
+        if (samples == 0) {
+            RtcTimeSeriesCodec::SetUint32(_block, seconds);
+        }
+        memcpy(_block + _position, encoded, count);
+        _position += count;
+        _block[4] = samples + 1;
+
+        if (samples > 0) {
+            _delta = delta;
+        }
+        _seconds = seconds;
+        _value = value;
+        return true;
+    }
+
+    uint8_t Count() const
+    {
+        return _block[4];
+    }
+
+    // the time of the last sample added
+    uint32_t LastSeconds() const
+    {
+        return _seconds;
+    }
+
+    // the bytes in use, the rest of the block is 0xff
+    uint8_t Size() const
+    {
+        return _position;
+    }
+
+    const uint8_t* Block() const
+    {
+        return _block;
+    }
+
+private:
+    uint8_t _block[V_BLOCK_SIZE];
+    uint8_t _position;
+    uint32_t _seconds;
+    int32_t _delta;
+    int32_t _value;
+};
+
+// Stores encoded blocks one after another in a region of a memory such as
+// EepromAt24c32 or the RtcDS3234 SRAM, anything with
+// SetMemory(address, pValue, count) and GetMemory(address, pValue, count).
+//
+// Samples are added to a block in RAM that is written when it is full or
+// when Flush() is called.  The first sample time of each block is at its
+// start, so a time window is found with a binary search over the block
+// headers and only the blocks in the window are decoded.
+//
+// Samples are appended in time order, one earlier than the last is refused
+// so the block headers stay sorted for the search.  Use a block size that
+// divides the 32 byte AT24C32 page.  Once the region is full Append fails,
+// Format() to start again.
+//
+// RtcTimeSeriesStore<EepromAt24c32<TwoWire>, 32> Store(Eeprom, 0, 4096);
+template<typename T_MEMORY, uint8_t V_BLOCK_SIZE = 32> class RtcTimeSeriesStore
+{
+public:
+    RtcTimeSeriesStore(T_MEMORY& memory,
+            uint16_t startAddress,
+            uint16_t countBytes) :
+        _memory(memory),
+        _startAddress(startAddress),
+        _blockCapacity(countBytes / V_BLOCK_SIZE),
+        _blockIndex(0),
+        _lastSeconds(0)
+    {
+    }
+
+    // finds the first unused block with a binary search and continues the
+    // block before it
+    bool Begin()
+    {
+        uint16_t low = 0;
+        uint16_t high = _blockCapacity;
+
+        _encoder.Reset();
+        _lastSeconds = 0;
+
+        while (low < high) {
+            uint16_t middle = low + (high - low) / 2;
+            uint8_t count;
+
+            if (_memory.GetMemory(blockAddress(middle) + 4, &count, 1) != 1) return false;
+
+            if (count != c_TimeSeriesCountUnused) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        _blockIndex = low;
+        if (low > 0) {
+            uint8_t block[V_BLOCK_SIZE];
+
+            if (_memory.GetMemory(blockAddress(low - 1), block, V_BLOCK_SIZE) != V_BLOCK_SIZE) return false;
+            if (_encoder.Load(block)) {
+                _blockIndex = low - 1;
+                _lastSeconds = _encoder.LastSeconds();
+            }
+            else {
+                // the samples could not be decoded, the block starts no
+                // earlier than its header
+                _lastSeconds = RtcTimeSeriesCodec::GetUint32(block);
+            }
+        }
+
+        return true;
+    }
+
+    // marks every block as unused, only the headers are written as Begin()
+    // goes by the sample count in them and decoding never reads past the
+    // bytes that count covers
+    bool Format()
+    {
+        uint8_t header[c_TimeSeriesHeaderSize];
+
+        memset(header, 0xff, sizeof(header));
+
+        for (uint16_t index = 0; index < _blockCapacity; index++) {
+            if (_memory.SetMemory(blockAddress(index), header, sizeof(header)) != sizeof(header))
+                return false;
+        }
+
+        _blockIndex = 0;
+        _encoder.Reset();
+        _lastSeconds = 0;
+        return true;
+    }
+
+    // false once the region is full or when the sample is earlier than the
+    // last one, which would start a block out of order
+    bool Append(const RtcDateTime& time, int32_t value)
+    {
+        uint32_t seconds = time.TotalSeconds();
+
+        if (_blockIndex >= _blockCapacity || seconds < _lastSeconds) return false;
+
+        if (!_encoder.Add(seconds, value)) {
+            // the sample starts the next block
+            if (!writeBlock()) return false;
+
+            _blockIndex++;
+            _encoder.Reset();
+            if (_blockIndex >= _blockCapacity) return false;
+
+            if (!_encoder.Add(seconds, value)) return false;
+        }
+
+        _lastSeconds = seconds;
+        return true;
+    }
+
+    // writes the partly filled block
+    bool Flush()
+    {
+        if (_blockIndex >= _blockCapacity || _encoder.Count() == 0) return true;
+
+        return writeBlock();
+    }
+
+    // the blocks holding samples, including the one being filled
+    uint16_t BlockCount() const
+    {
+        return (_encoder.Count() == 0) ? _blockIndex : _blockIndex + 1;
+    }
+
+    uint16_t BlockCapacity() const
+    {
+        return _blockCapacity;
+    }
+
+    // calls back for each sample from start up to and including end
+    //
+    // callback(const RtcDateTime& time, int32_t value)
+    template<typename T_CALLBACK> uint16_t ForEachInRange(const RtcDateTime& start,
+        const RtcDateTime& end,
+        T_CALLBACK callback)
+    {
+        uint16_t countFound = 0;
+        uint16_t blockCount = BlockCount();
+        uint8_t block[V_BLOCK_SIZE];
+
+        for (uint16_t index = findBlock(start.TotalSeconds()); index < blockCount; index++) {
+            const uint8_t* pBlock = block;
+
+            if (index == _blockIndex) {
+                pBlock = _encoder.Block();
+            }
+            else if (_memory.GetMemory(blockAddress(index), block, V_BLOCK_SIZE) != V_BLOCK_SIZE) {
+                break;
+            }
+
+            RtcTimeSeriesDecoder decoder(pBlock, V_BLOCK_SIZE);
+            uint32_t seconds;
+            int32_t value;
+
+            while (decoder.Next(&seconds, &value)) {
+                if (seconds > end.TotalSeconds()) return countFound;
+
+                if (seconds >= start.TotalSeconds()) {
+                    callback(RtcDateTime(seconds), value);
+                    countFound++;
+                }
+            }
+        }
+
+        return countFound;
+    }
+
+private:
+    T_MEMORY& _memory;
+    const uint16_t _startAddress;
+    const uint16_t _blockCapacity;
+
+    uint16_t _blockIndex;
+    uint32_t _lastSeconds;
+    RtcTimeSeriesEncoder<V_BLOCK_SIZE> _encoder;
+
+    uint16_t blockAddress(uint16_t index) const
+    {
+        return _startAddress + index * V_BLOCK_SIZE;
+    }
+
+    bool writeBlock()
+    {
+        uint8_t countBytes = _encoder.Size();
+
+        return (_memory.SetMemory(blockAddress(_blockIndex), _encoder.Block(), countBytes) == countBytes);
+    }
+
+    // the last block starting at or before the time
+    uint16_t findBlock(uint32_t seconds)
+    {
+        uint16_t low = 0;
+        uint16_t high = BlockCount();
+
+        while (low < high) {
+            uint16_t middle = low + (high - low) / 2;
+            uint8_t header[4];
+            const uint8_t* pHeader = header;
+
+            if (middle == _blockIndex) {
+                pHeader = _encoder.Block();
+            }
+            else if (_memory.GetMemory(blockAddress(middle), header, sizeof(header)) != sizeof(header)) {
+                return 0;
+            }
+
+            if (RtcTimeSeriesCodec::GetUint32(pHeader) <= seconds) {
+                low = middle + 1;
+            }
+            else {
+                high = middle;
+            }
+        }
+
+        return (low > 0) ? low - 1 : 0;
+    }
+};
+
+#endif // __RTCTIMESERIES_H__
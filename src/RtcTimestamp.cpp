@@ -0,0 +1,27 @@
+#include <Arduino.h>
+#include "RtcTimestamp.h"
+
+uint32_t RtcNextBoundary(const RtcTimestamp& reference,
+    uint32_t referenceMicros,
+    uint32_t leadMicros,
+    uint32_t* pStartMicros)
+{
+    uint32_t seconds = reference.TotalSeconds() + 1;
+    uint32_t start = referenceMicros + (1000000 - reference.Microseconds()) - leadMicros;
+    uint32_t now = micros();
+
+    // a second too close, or already past, is skipped
+    while (static_cast<int32_t>(start - now) < static_cast<int32_t>(c_RtcBoundaryMarginMicros)) {
+        seconds++;
+        start += 1000000;
+    }
+
+    *pStartMicros = start;
+    return seconds;
+}
+
+void RtcWaitForMicros(uint32_t startMicros)
+{
+    while (static_cast<int32_t>(startMicros - micros()) > 0) {
+    }
+}
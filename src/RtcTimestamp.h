@@ -0,0 +1,97 @@
+#ifndef __RTCTIMESTAMP_H__
+#define __RTCTIMESTAMP_H__
+
+#include <Arduino.h>
+
+#include "RtcDateTime.h"
+
+// the fraction counts the edges of the 32768Hz RTC output
+const uint8_t c_RtcTimestampFractionBits = 15;
+const uint16_t c_RtcTimestampFractionsPerSecond = 1 << c_RtcTimestampFractionBits;
+
+// A time with 1/32768 second resolution, about 30.5us, as seconds since 2000
+// like RtcDateTime::TotalSeconds() and a fraction of a second
+class RtcTimestamp
+{
+public:
+    RtcTimestamp(uint32_t secondsFrom2000 = 0, uint16_t fraction = 0) :
+        _seconds(secondsFrom2000 + (fraction >> c_RtcTimestampFractionBits)),
+        _fraction(fraction & (c_RtcTimestampFractionsPerSecond - 1))
+    {
+    }
+
+    uint32_t TotalSeconds() const
+    {
+        return _seconds;
+    }
+
+    // 0 - 32767
+    uint16_t Fraction() const
+    {
+        return _fraction;
+    }
+
+    // 1000000 / 32768 is 15625 / 512
+    uint32_t Microseconds() const
+    {
+        return (static_cast<uint32_t>(_fraction) * 15625) >> 9;
+    }
+
+    uint16_t Milliseconds() const
+    {
+        return (static_cast<uint32_t>(_fraction) * 1000) >> c_RtcTimestampFractionBits;
+    }
+
+    RtcDateTime DateTime() const
+    {
+        return RtcDateTime(_seconds);
+    }
+
+    // in 1/32768 seconds, the difference must be within about 18 hours
+    int32_t operator-(const RtcTimestamp& other) const
+    {
+        return static_cast<int32_t>(_seconds - other._seconds) * c_RtcTimestampFractionsPerSecond +
+            (static_cast<int32_t>(_fraction) - other._fraction);
+    }
+
+    bool operator==(const RtcTimestamp& other) const
+    {
+        return (_seconds == other._seconds && _fraction == other._fraction);
+    }
+
+    bool operator!=(const RtcTimestamp& other) const
+    {
+        return !(*this == other);
+    }
+
+    bool operator<(const RtcTimestamp& other) const
+    {
+        return (_seconds < other._seconds || (_seconds == other._seconds && _fraction < other._fraction));
+    }
+
+    bool operator>(const RtcTimestamp& other) const
+    {
+        return (other < *this);
+    }
+
+private:
+    uint32_t _seconds;
+    uint16_t _fraction;
+};
+
+// the time allowed to prepare a write before the boundary it is for
+const uint16_t c_RtcBoundaryMarginMicros = 3000;
+
+// Finds the next whole second of a reference time, such as from NTP or GPS,
+// that a write started leadMicros early can still make.  The reference was
+// taken at micros() referenceMicros and should be recent.  Returns that
+// second and the micros() to start the write at.
+extern uint32_t RtcNextBoundary(const RtcTimestamp& reference,
+    uint32_t referenceMicros,
+    uint32_t leadMicros,
+    uint32_t* pStartMicros);
+
+// busy waits for micros() to reach startMicros
+extern void RtcWaitForMicros(uint32_t startMicros);
+
+#endif // __RTCTIMESTAMP_H__
@@ -22,6 +22,24 @@
 #endif // !defined(ISR_ATTR)
 
 
+// Arduino Wire libraries commonly buffer 32 bytes in each direction, reads
+// larger than this are split into several requests.  Define it before
+// including the library when the platform Wire buffer is a different size
+#if !defined(RTC_WIRE_BUFFER_SIZE)
+#define RTC_WIRE_BUFFER_SIZE 32
+#endif
+
+// the Wire endTransmission error for a timeout
+const uint8_t c_RtcWireTimeoutError = 5;
+
+// the progress of a stepped operation, see the Start/Process/Complete methods
+enum RtcAsyncState {
+    RtcAsyncState_Idle,     // nothing started, or the result was collected
+    RtcAsyncState_Busy,     // call Process again later
+    RtcAsyncState_Complete, // call Complete to collect the result
+    RtcAsyncState_Error,    // see LastError()
+};
+
 // for some reason, the DUE board support does not define this, even though other non AVR archs do
 #ifndef _BV
 #define _BV(b) (1UL << (b))
@@ -31,4 +49,8 @@ extern uint8_t BcdToUint8(uint8_t val);
 extern uint8_t Uint8ToBcd(uint8_t val);
 extern uint8_t BcdToBin24Hour(uint8_t bcdHour);
 
+// table driven CRC-8/MAXIM, pass the last result as crc to continue over
+// more data
+extern uint8_t RtcCrc8(const uint8_t* pData, uint8_t countBytes, uint8_t crc = 0);
+
 #endif // __RTCUTILITY_H__
@@ -0,0 +1,112 @@
+#ifndef __RTCWIRESPLITREAD_H__
+#define __RTCWIRESPLITREAD_H__
+
+#include <Arduino.h>
+
+#include "RtcUtility.h"
+
+const uint16_t c_RtcWireSplitReadTimeoutMs = 25;
+
+// A split phase burst register read, the phases are spread over several
+// calls so that the caller is only held for one bus phase at a time:
+// Start() addresses the register, the first Process() requests the bytes
+// and later calls collect them once available() reports they have all
+// arrived.
+//
+// This is not a non blocking read.  The stock Arduino Wire library
+// completes requestFrom() before it returns, so there the first Process()
+// waits out the read phase on the bus and only the addressing is split
+// from it.  The read only overlaps the caller's work with a Wire library
+// that completes requestFrom() in the background.
+//
+// The drivers do not hold one, a sketch that wants the split phase read
+// declares the SplitDateTime of the driver and passes it in.
+template<typename T_WIRE_METHOD, uint8_t V_COUNT> class RtcWireSplitRead
+{
+public:
+    RtcWireSplitRead(T_WIRE_METHOD& wire) :
+        _wire(wire),
+        _state(RtcAsyncState_Idle),
+        _isRequested(false),
+        _lastError(0),
+        _address(0),
+        _startMillis(0)
+    {
+    }
+
+    bool Start(uint8_t address, uint8_t regAddress)
+    {
+        _address = address;
+        _isRequested = false;
+        _startMillis = millis();
+
+        _wire.beginTransmission(address);
+        _wire.write(regAddress);
+
+        _lastError = _wire.endTransmission();
+        _state = _lastError ? RtcAsyncState_Error : RtcAsyncState_Busy;
+        return !_lastError;
+    }
+
+    RtcAsyncState Process()
+    {
+        if (_state != RtcAsyncState_Busy)
+            return _state;
+
+        if (!_isRequested) {
+            _isRequested = true;
+
+            uint8_t bytesRequested = _wire.requestFrom(_address, V_COUNT);
+            if (bytesRequested != V_COUNT) {
+                _lastError = 4;
+                _state = RtcAsyncState_Error;
+            }
+            return _state;
+        }
+
+        // the time is taken first, so an interrupt between the two does
+        // not time out a read that has arrived meanwhile
+        bool isExpired = (millis() - _startMillis > c_RtcWireSplitReadTimeoutMs);
+
+        if (_wire.available() >= V_COUNT) {
+            for (uint8_t index = 0; index < V_COUNT; index++)
+                _regs[index] = _wire.read();
+            _state = RtcAsyncState_Complete;
+        }
+        else if (isExpired) {
+            _lastError = c_RtcWireTimeoutError;
+            _state = RtcAsyncState_Error;
+        }
+
+        return _state;
+    }
+
+    RtcAsyncState State() const
+    {
+        return _state;
+    }
+
+    uint8_t LastError() const
+    {
+        return _lastError;
+    }
+
+    // the registers read, valid once Process() has returned Complete,
+    // collecting them returns the state to Idle
+    const uint8_t* Complete()
+    {
+        _state = RtcAsyncState_Idle;
+        return _regs;
+    }
+
+private:
+    T_WIRE_METHOD& _wire;
+    RtcAsyncState _state;
+    bool _isRequested;
+    uint8_t _lastError;
+    uint8_t _address;
+    uint32_t _startMillis;
+    uint8_t _regs[V_COUNT];
+};
+
+#endif // __RTCWIRESPLITREAD_H__
@@ -81,11 +81,81 @@ public:
         return value;
     }
 
+    // burst transfers of data bytes, the bits are unrolled and none of the
+    // command handling of write() is needed.  RtcDS1302 uses these for every
+    // burst when they are there, a replacement for ThreeWire without them
+    // bursts through read() and write().
+    void writeBytes(const uint8_t* pValues, uint8_t countBytes) {
+        while (countBytes--) {
+            uint8_t value = *pValues++;
+
+            writeBit(value & 0x01);
+            writeBit(value & 0x02);
+            writeBit(value & 0x04);
+            writeBit(value & 0x08);
+            writeBit(value & 0x10);
+            writeBit(value & 0x20);
+            writeBit(value & 0x40);
+            writeBit(value & 0x80);
+        }
+    }
+
+    void readBytes(uint8_t* pValues, uint8_t countBytes) {
+        while (countBytes--) {
+            uint8_t value = readBit();
+
+            value |= readBit() << 1;
+            value |= readBit() << 2;
+            value |= readBit() << 3;
+            value |= readBit() << 4;
+            value |= readBit() << 5;
+            value |= readBit() << 6;
+            value |= readBit() << 7;
+
+            *pValues++ = value;
+        }
+    }
+
 private:
     const uint8_t _ioPin;
     const uint8_t _clkPin;
     const uint8_t _cePin;
 
+    void writeBit(uint8_t bit) {
+        digitalWrite(_ioPin, bit ? HIGH : LOW);
+        burstDelay();             // tDC = 200ns
+
+        digitalWrite(_clkPin, HIGH);
+        burstDelay();             // tCH = 1000ns, tCDH = 800ns
+
+        digitalWrite(_clkPin, LOW);
+        burstDelay();             // tCL=1000ns, tCDD=800ns
+    }
+
+    uint8_t readBit() {
+        uint8_t bit = digitalRead(_ioPin);
+
+        digitalWrite(_clkPin, HIGH);
+        burstDelay();             // tCH = 1000ns
+
+        digitalWrite(_clkPin, LOW);
+        burstDelay();             // tCL=1000ns, tCDD=800ns
+
+        return bit;
+    }
+
+    // the longest of the DS1302 phases at 2V is tCH = tCL = 1000ns.  On AVR
+    // that is counted in cycles of F_CPU, as ThreeWireDirect does, rather
+    // than rounded to a whole delayMicroseconds(), other cores keep the
+    // microsecond, use ThreeWireDirect there for timing to the nanosecond.
+    static void burstDelay() {
+#if defined(F_CPU) && defined(ARDUINO_ARCH_AVR)
+        __builtin_avr_delay_cycles((1000UL * (F_CPU / 1000000UL) + 999) / 1000);
+#else
+        delayMicroseconds(1);
+#endif
+    }
+
     void resetPins() {
         // just making sure they are in a default low power use state
         // as required state is set when transmissions are started
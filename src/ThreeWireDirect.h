@@ -0,0 +1,404 @@
+#ifndef __THREEWIREDIRECT_H__
+#define __THREEWIREDIRECT_H__
+
+#include <Arduino.h>
+
+#include "ThreeWire.h"
+
+// DS1302 interface timing in nanoseconds, the worst case at VCC = 2.0V
+struct ThreeWireTiming2V
+{
+    static const uint16_t DataToClockSetup = 200;  // tDC
+    static const uint16_t ClockHigh = 1000;        // tCH
+    static const uint16_t ClockLow = 1000;         // tCL
+    static const uint16_t ClockToDataDelay = 800;  // tCDD
+    static const uint16_t CeToClockSetup = 4000;   // tCC
+    static const uint16_t CeInactive = 4000;       // tCWH
+};
+
+// DS1302 interface timing in nanoseconds at VCC = 5.0V
+struct ThreeWireTiming5V
+{
+    static const uint16_t DataToClockSetup = 50;   // tDC
+    static const uint16_t ClockHigh = 250;         // tCH
+    static const uint16_t ClockLow = 250;          // tCL
+    static const uint16_t ClockToDataDelay = 200;  // tCDD
+    static const uint16_t CeToClockSetup = 1000;   // tCC
+    static const uint16_t CeInactive = 1000;       // tCWH
+};
+
+// A single pin accessed through the GPIO registers where the platform
+// allows, otherwise through digitalWrite/digitalRead
+#if defined(ARDUINO_ARCH_AVR)
+
+template<uint8_t V_PIN> class ThreeWireDirectPin
+{
+public:
+    // the port lookups live in PROGMEM tables, so they are only done once
+    ThreeWireDirectPin() :
+        _mask(digitalPinToBitMask(V_PIN)),
+        _output(portOutputRegister(digitalPinToPort(V_PIN))),
+        _input(portInputRegister(digitalPinToPort(V_PIN))),
+        _mode(portModeRegister(digitalPinToPort(V_PIN)))
+    {
+    }
+
+    void High()
+    {
+        *_output |= _mask;
+    }
+    void Low()
+    {
+        *_output &= ~_mask;
+    }
+    bool Read()
+    {
+        return (*_input & _mask);
+    }
+    void Output()
+    {
+        *_mode |= _mask;
+    }
+    void Input()
+    {
+        // without the pull up, which would fight the DS1302 pull down
+        *_mode &= ~_mask;
+        *_output &= ~_mask;
+    }
+
+private:
+    const uint8_t _mask;
+    volatile uint8_t* const _output;
+    volatile uint8_t* const _input;
+    volatile uint8_t* const _mode;
+};
+
+// the port updates are read-modify-write, so interrupts are held off for
+// each byte to keep an ISR writing the same port from being undone
+class ThreeWireDirectLock
+{
+public:
+    ThreeWireDirectLock() :
+        _sreg(SREG)
+    {
+        cli();
+    }
+    ~ThreeWireDirectLock()
+    {
+        SREG = _sreg;
+    }
+
+private:
+    const uint8_t _sreg;
+};
+
+#elif defined(ARDUINO_ARCH_ESP8266)
+
+template<uint8_t V_PIN> class ThreeWireDirectPin
+{
+public:
+    static_assert(V_PIN < 16, "ThreeWireDirect supports GPIO0 to GPIO15");
+
+    void High()
+    {
+        GPOS = _BV(V_PIN);
+    }
+    void Low()
+    {
+        GPOC = _BV(V_PIN);
+    }
+    bool Read()
+    {
+        return GPIP(V_PIN);
+    }
+    void Output()
+    {
+        GPES = _BV(V_PIN);
+    }
+    void Input()
+    {
+        GPEC = _BV(V_PIN);
+    }
+};
+
+// the set and clear registers are atomic
+class ThreeWireDirectLock
+{
+public:
+    ThreeWireDirectLock()
+    {
+    }
+};
+
+#elif defined(ARDUINO_ARCH_ESP32)
+
+template<uint8_t V_PIN> class ThreeWireDirectPin
+{
+public:
+    static_assert(V_PIN < 32, "ThreeWireDirect supports GPIO0 to GPIO31");
+
+    void High()
+    {
+        REG_WRITE(GPIO_OUT_W1TS_REG, _BV(V_PIN));
+    }
+    void Low()
+    {
+        REG_WRITE(GPIO_OUT_W1TC_REG, _BV(V_PIN));
+    }
+    bool Read()
+    {
+        return (REG_READ(GPIO_IN_REG) >> V_PIN) & 1;
+    }
+    void Output()
+    {
+        REG_WRITE(GPIO_ENABLE_W1TS_REG, _BV(V_PIN));
+    }
+    void Input()
+    {
+        REG_WRITE(GPIO_ENABLE_W1TC_REG, _BV(V_PIN));
+    }
+};
+
+// the set and clear registers are atomic
+class ThreeWireDirectLock
+{
+public:
+    ThreeWireDirectLock()
+    {
+    }
+};
+
+#else
+
+template<uint8_t V_PIN> class ThreeWireDirectPin
+{
+public:
+    void High()
+    {
+        digitalWrite(V_PIN, HIGH);
+    }
+    void Low()
+    {
+        digitalWrite(V_PIN, LOW);
+    }
+    bool Read()
+    {
+        return digitalRead(V_PIN);
+    }
+    void Output()
+    {
+        pinMode(V_PIN, OUTPUT);
+    }
+    void Input()
+    {
+        pinMode(V_PIN, INPUT);
+    }
+};
+
+class ThreeWireDirectLock
+{
+public:
+    ThreeWireDirectLock()
+    {
+    }
+};
+
+#endif
+
+// A ThreeWire with the pins given as template arguments, so that they are
+// driven through the GPIO registers on AVR, ESP8266 and ESP32.  On ESP8266
+// and ESP32 the registers and bits are constants, on AVR the port and mask
+// come from the PROGMEM pin tables of the core, which are not constexpr, so
+// they are looked up once when the ThreeWireDirect is constructed.  The clock
+// phases are timed in cpu cycles from the DS1302 specifications given by
+// T_TIMING rather than whole microseconds, use ThreeWireTiming5V when the
+// DS1302 is powered from 5V.  Without F_CPU they fall back to whole
+// microseconds.
+//
+// ThreeWireDirect<4, 5, 2> myWire; // IO, SCLK, CE
+// RtcDS1302<ThreeWireDirect<4, 5, 2>> Rtc(myWire);
+template<uint8_t V_IO_PIN,
+    uint8_t V_CLK_PIN,
+    uint8_t V_CE_PIN,
+    typename T_TIMING = ThreeWireTiming2V> class ThreeWireDirect
+{
+public:
+    void begin() {
+        resetPins();
+    }
+
+    void end() {
+        resetPins();
+    }
+
+    void beginTransmission(uint8_t command) {
+        _ce.Low(); // default, not enabled
+        _ce.Output();
+
+        _clk.Low(); // default, clock low
+        _clk.Output();
+
+        _io.Output();
+
+        _ce.High(); // start the session
+        delayNanoseconds<T_TIMING::CeToClockSetup>();
+
+        write(command, (command & THREEWIRE_READFLAG) == THREEWIRE_READFLAG);
+    }
+
+    void endTransmission() {
+        _ce.Low();
+        delayNanoseconds<T_TIMING::CeInactive>();
+    }
+
+    void write(uint8_t value, bool isDataRequestCommand = false) {
+        ThreeWireDirectLock lock;
+
+        for (uint8_t bit = 0; bit < 8; ++bit, value >>= 1) {
+            if (value & 1) _io.High();
+            else           _io.Low();
+            delayNanoseconds<T_TIMING::DataToClockSetup>();
+
+            // clock up, data is read by DS1302
+            _clk.High();
+            delayNanoseconds<T_TIMING::ClockHigh>();
+
+            // for the last bit before a read
+            // Set IO line for input before the clock down
+            if (bit == 7 && isDataRequestCommand)
+                _io.Input();
+
+            _clk.Low();
+            delayNanoseconds<ClockLowToData>();
+        }
+    }
+
+    uint8_t read() {
+        ThreeWireDirectLock lock;
+        uint8_t value = 0;
+
+        for (uint8_t bit = 0; bit < 8; ++bit) {
+            // first bit is present on io pin, so only clock the other
+            // bits
+            value |= _io.Read() << bit;
+
+            // Clock up, prepare for next
+            _clk.High();
+            delayNanoseconds<T_TIMING::ClockHigh>();
+
+            // Clock down, value is ready after some time.
+            _clk.Low();
+            delayNanoseconds<ClockLowToData>();
+        }
+
+        return value;
+    }
+
+    // burst transfers of data bytes, the bits are unrolled and none of the
+    // command handling of write() is needed
+    void writeBytes(const uint8_t* pValues, uint8_t countBytes) {
+        while (countBytes--) {
+            ThreeWireDirectLock lock;
+            uint8_t value = *pValues++;
+
+            writeBit(value & 0x01);
+            writeBit(value & 0x02);
+            writeBit(value & 0x04);
+            writeBit(value & 0x08);
+            writeBit(value & 0x10);
+            writeBit(value & 0x20);
+            writeBit(value & 0x40);
+            writeBit(value & 0x80);
+        }
+    }
+
+    void readBytes(uint8_t* pValues, uint8_t countBytes) {
+        while (countBytes--) {
+            ThreeWireDirectLock lock;
+            uint8_t value = readBit();
+
+            value |= readBit() << 1;
+            value |= readBit() << 2;
+            value |= readBit() << 3;
+            value |= readBit() << 4;
+            value |= readBit() << 5;
+            value |= readBit() << 6;
+            value |= readBit() << 7;
+
+            *pValues++ = value;
+        }
+    }
+
+private:
+    // after the clock falls the next bit is both clocked and sampled
+    static const uint16_t ClockLowToData = (T_TIMING::ClockLow > T_TIMING::ClockToDataDelay) ?
+        T_TIMING::ClockLow : T_TIMING::ClockToDataDelay;
+
+    ThreeWireDirectPin<V_IO_PIN> _io;
+    ThreeWireDirectPin<V_CLK_PIN> _clk;
+    ThreeWireDirectPin<V_CE_PIN> _ce;
+
+#if defined(F_CPU)
+    static constexpr uint32_t nanosecondsToCycles(uint32_t nanoseconds)
+    {
+        return (nanoseconds * (F_CPU / 1000000UL) + 999) / 1000;
+    }
+#endif
+
+    // at least the given time, the pin access itself is not subtracted,
+    // whole microseconds when the cpu clock is not known
+    template<uint16_t V_NANOSECONDS> static void delayNanoseconds()
+    {
+#if defined(F_CPU) && defined(ARDUINO_ARCH_AVR)
+        __builtin_avr_delay_cycles(nanosecondsToCycles(V_NANOSECONDS));
+#elif defined(F_CPU) && (defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32))
+        uint32_t start = ESP.getCycleCount();
+        while (ESP.getCycleCount() - start < nanosecondsToCycles(V_NANOSECONDS))
+        {
+        }
+#else
+        delayMicroseconds((V_NANOSECONDS + 999) / 1000);
+#endif
+    }
+
+    void writeBit(uint8_t bit) {
+        if (bit) _io.High();
+        else     _io.Low();
+        delayNanoseconds<T_TIMING::DataToClockSetup>();
+
+        _clk.High();
+        delayNanoseconds<T_TIMING::ClockHigh>();
+
+        _clk.Low();
+        delayNanoseconds<ClockLowToData>();
+    }
+
+    uint8_t readBit() {
+        uint8_t bit = _io.Read();
+
+        _clk.High();
+        delayNanoseconds<T_TIMING::ClockHigh>();
+
+        _clk.Low();
+        delayNanoseconds<ClockLowToData>();
+
+        return bit;
+    }
+
+    void resetPins() {
+        // just making sure they are in a default low power use state
+        // as required state is set when transmissions are started
+        // three wire devices have internal pull downs so they will be low
+        pinMode(V_CLK_PIN, INPUT);
+        pinMode(V_IO_PIN, INPUT);
+        pinMode(V_CE_PIN, INPUT);
+
+        // the direct access only switches the direction, so leave the
+        // outputs low with any pwm or pull up released
+        digitalWrite(V_CLK_PIN, LOW);
+        digitalWrite(V_IO_PIN, LOW);
+        digitalWrite(V_CE_PIN, LOW);
+    }
+};
+
+#endif // __THREEWIREDIRECT_H__